@@ -111,6 +111,8 @@ macro(dune_probe_headers)
   dune_test_header(linux/rtc.h)
   dune_test_header(linux/input.h)
   dune_test_header(linux/spi/spidev.h)
+  dune_test_header(linux/can.h)
+  dune_test_header(linux/can/raw.h)
   dune_test_header(netdb.h)
   dune_test_header(pthread.h)
   dune_test_header(signal.h)
@@ -78,7 +78,7 @@ BODY = [
     # onMain.
     '//! Main loop.',
     'void', 'onMain(void)', '{',
-    'while (!stopping())', '{', 'waitForMessages(1.0);', '}', '}', '};'
+    'while (!stopping())', '{', 'waitForMessages();', '}', '}', '};'
     ]
 
 class Task:
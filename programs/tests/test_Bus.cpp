@@ -0,0 +1,155 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/IMC/Bus.hpp>
+#include <DUNE/IMC/Definitions.hpp>
+#include <DUNE/IMC/SourcePredicate.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+//! Task that counts the messages it receives.
+class Counter: public Tasks::AbstractTask
+{
+public:
+  Counter(void):
+    count(0)
+  { }
+
+  void
+  receive(const IMC::Message* msg)
+  {
+    (void)msg;
+    ++count;
+  }
+
+  const char*
+  getName(void) const
+  {
+    return "Counter";
+  }
+
+  void
+  inf(const char*, ...)
+  { }
+
+  void
+  war(const char*, ...)
+  { }
+
+  void
+  err(const char*, ...)
+  { }
+
+  void
+  cri(const char*, ...)
+  { }
+
+  void
+  debug(const char*, ...)
+  { }
+
+  void
+  trace(const char*, ...)
+  { }
+
+  void
+  spew(const char*, ...)
+  { }
+
+  unsigned count;
+
+protected:
+  void
+  run(void)
+  { }
+};
+
+static unsigned
+deliver(IMC::Bus& bus, Counter& task, unsigned system, unsigned entity)
+{
+  IMC::Depth msg;
+  msg.setSource(system);
+  msg.setSourceEntity(entity);
+
+  task.count = 0;
+  bus.dispatch(&msg);
+  return task.count;
+}
+
+int
+main(void)
+{
+  Test test("IMC::Bus Source Predicates");
+
+  {
+    IMC::SourcePredicate any;
+    IMC::Depth msg;
+    msg.setSource(10);
+    msg.setSourceEntity(20);
+    test.boolean("default predicate matches any source", any.isAny() && any.match(&msg));
+    test.boolean("entity predicate", IMC::SourcePredicate::fromEntity(20).match(&msg)
+                 && !IMC::SourcePredicate::fromEntity(21).match(&msg));
+    test.boolean("system predicate", IMC::SourcePredicate::fromSystem(10).match(&msg)
+                 && !IMC::SourcePredicate::fromSystem(11).match(&msg));
+    test.boolean("source predicate", IMC::SourcePredicate::fromSource(10, 20).match(&msg)
+                 && !IMC::SourcePredicate::fromSource(11, 20).match(&msg));
+    test.boolean("unresolved entity matches nothing",
+                 !IMC::SourcePredicate::fromEntity(0xffffffff).match(&msg));
+  }
+
+  {
+    IMC::Bus bus;
+    Counter task;
+    bus.registerRecipient(&task, IMC::Depth::getIdStatic());
+    test.boolean("unrestricted recipient", deliver(bus, task, 1, 5) == 1);
+
+    std::vector<IMC::SourcePredicate> sources;
+    sources.push_back(IMC::SourcePredicate::fromEntity(5));
+    bus.setRecipientSources(&task, IMC::Depth::getIdStatic(), sources);
+    test.boolean("accepted entity is delivered", deliver(bus, task, 1, 5) == 1);
+    test.boolean("other entity is discarded", deliver(bus, task, 1, 6) == 0);
+
+    sources.push_back(IMC::SourcePredicate::fromSource(2, 6));
+    bus.setRecipientSources(&task, IMC::Depth::getIdStatic(), sources);
+    test.boolean("union of predicates", deliver(bus, task, 2, 6) == 1
+                 && deliver(bus, task, 1, 6) == 0);
+
+    bus.setRecipientSources(&task, IMC::Depth::getIdStatic(), std::vector<IMC::SourcePredicate>());
+    test.boolean("cleared predicates accept any source", deliver(bus, task, 3, 7) == 1);
+
+    bus.unregisterRecipient(&task, IMC::Depth::getIdStatic());
+    test.boolean("unregistered recipient", deliver(bus, task, 1, 5) == 0);
+  }
+
+  return test.getReturnValue();
+}
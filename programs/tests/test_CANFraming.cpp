@@ -0,0 +1,188 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Task headers.
+#include <Transports/CAN/Framing.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using Transports::CAN::Fragmenter;
+using Transports::CAN::Reassembler;
+
+typedef std::vector<Hardware::CANSocket::Frame> Frames;
+
+//! Base identifier of the frames.
+static const uint32_t c_base_id = 0x600;
+
+//! Split an EulerAngles message sent by a node in frames.
+static void
+send(Fragmenter& fragmenter, uint16_t src, double psi, Frames& frames)
+{
+  IMC::EulerAngles ea;
+  ea.setSource(src);
+  ea.psi = psi;
+
+  std::vector<uint8_t> bfr(ea.getSerializationSize());
+  IMC::Packet::serialize(&ea, &bfr[0], bfr.size());
+  fragmenter.split(&bfr[0], bfr.size(), frames);
+}
+
+//! Feed frames to a reassembler and collect the decoded messages.
+static void
+feed(Reassembler& reassembler, const Frames& frames, std::vector<IMC::EulerAngles>& msgs)
+{
+  for (size_t i = 0; i < frames.size(); ++i)
+  {
+    IMC::Parser* parser = reassembler.handleFrame(frames[i]);
+    if (parser == NULL)
+      continue;
+
+    for (unsigned j = 1; j < frames[i].length; ++j)
+    {
+      IMC::Message* m = parser->parse(frames[i].data[j]);
+      if (m == NULL)
+        continue;
+
+      if (m->getId() == IMC::EulerAngles::getIdStatic())
+        msgs.push_back(*static_cast<IMC::EulerAngles*>(m));
+
+      delete m;
+    }
+  }
+}
+
+int
+main(void)
+{
+  Test test("CAN Framing");
+
+  {
+    Fragmenter node1;
+    node1.setIdentifier(c_base_id | 1);
+    Reassembler rx;
+    rx.setNode(3);
+
+    Frames frames;
+    std::vector<IMC::EulerAngles> msgs;
+    unsigned count = 0;
+
+    // Enough frames for the 7 bit sequence number to wrap twice.
+    for (unsigned i = 0; i < 40; ++i)
+    {
+      send(node1, 1, i, frames);
+      count += frames.size();
+      feed(rx, frames, msgs);
+    }
+
+    bool ordered = msgs.size() == 40;
+    for (unsigned i = 0; ordered && i < msgs.size(); ++i)
+      ordered = msgs[i].psi == i;
+
+    test.boolean("sequence wraps", count > 256 && ordered && rx.getLost() == 0);
+  }
+
+  {
+    Fragmenter node1;
+    node1.setIdentifier(c_base_id | 1);
+    Reassembler rx;
+    rx.setNode(3);
+
+    Frames frames;
+    std::vector<IMC::EulerAngles> msgs;
+
+    send(node1, 1, 1.0, frames);
+    frames.erase(frames.begin() + 3);
+    feed(rx, frames, msgs);
+    test.boolean("lost frame discards packet", msgs.empty() && rx.getLost() == 1);
+
+    send(node1, 1, 2.0, frames);
+    feed(rx, frames, msgs);
+    test.boolean("next packet decoded after loss", msgs.size() == 1 && msgs[0].psi == 2.0);
+  }
+
+  {
+    Fragmenter node1;
+    node1.setIdentifier(c_base_id | 1);
+    Fragmenter node2;
+    node2.setIdentifier(c_base_id | 2);
+    Reassembler rx;
+    rx.setNode(3);
+
+    Frames frames1;
+    Frames frames2;
+    send(node1, 1, 1.0, frames1);
+    send(node2, 2, 2.0, frames2);
+
+    Frames frames;
+    for (size_t i = 0; i < std::max(frames1.size(), frames2.size()); ++i)
+    {
+      if (i < frames1.size())
+        frames.push_back(frames1[i]);
+      if (i < frames2.size())
+        frames.push_back(frames2[i]);
+    }
+
+    std::vector<IMC::EulerAngles> msgs;
+    feed(rx, frames, msgs);
+
+    bool both = msgs.size() == 2
+    && ((msgs[0].getSource() == 1 && msgs[0].psi == 1.0 && msgs[1].getSource() == 2 && msgs[1].psi == 2.0)
+        || (msgs[0].getSource() == 2 && msgs[0].psi == 2.0 && msgs[1].getSource() == 1 && msgs[1].psi == 1.0));
+    test.boolean("interleaved senders", both && rx.getLost() == 0);
+  }
+
+  {
+    Fragmenter node3;
+    node3.setIdentifier(c_base_id | 3);
+    Reassembler rx;
+    rx.setNode(3);
+
+    Frames frames;
+    std::vector<IMC::EulerAngles> msgs;
+    send(node3, 3, 1.0, frames);
+    feed(rx, frames, msgs);
+    test.boolean("own frames ignored", msgs.empty());
+
+    rx.setNode(4);
+    send(node3, 3, 1.0, frames);
+    feed(rx, frames, msgs);
+    test.boolean("frames of other nodes decoded", msgs.size() == 1);
+  }
+
+  return test.getReturnValue();
+}
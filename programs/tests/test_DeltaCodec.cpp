@@ -0,0 +1,222 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Algorithms/CRC16.hpp>
+#include <DUNE/IMC/Definitions.hpp>
+#include <DUNE/IMC/DeltaCodec.hpp>
+#include <DUNE/IMC/Packet.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+static void
+write(std::ostream& os, Utils::ByteBuffer& bfr)
+{
+  os.write(bfr.getBufferSigned(), bfr.getSize());
+}
+
+//! Write a 16-bit value in the other byte order.
+static void
+putForeign(uint16_t value, uint8_t* dst)
+{
+  std::memcpy(dst, &value, sizeof(value));
+  std::reverse(dst, dst + sizeof(value));
+}
+
+//! Serialize a message without payload in the other byte order.
+static std::vector<uint8_t>
+toForeign(const IMC::Message* msg)
+{
+  // Offset and size of the multi-byte header fields.
+  static const unsigned c_fields[][2] = {{0, 2}, {2, 2}, {4, 2}, {6, 8}, {14, 2}, {17, 2}};
+
+  Utils::ByteBuffer bfr;
+  uint16_t size = IMC::Packet::serialize(msg, bfr);
+  std::vector<uint8_t> pkt(bfr.getBuffer(), bfr.getBuffer() + size);
+
+  for (unsigned i = 0; i < sizeof(c_fields) / sizeof(c_fields[0]); ++i)
+    std::reverse(&pkt[c_fields[i][0]], &pkt[c_fields[i][0] + c_fields[i][1]]);
+
+  uint16_t crc = Algorithms::CRC16::compute(&pkt[0], size - 2);
+  putForeign(crc, &pkt[size - 2]);
+  return pkt;
+}
+
+//! Build a delta frame of a packet in the other byte order, or the
+//! marker frame if the packet is empty.
+static std::vector<uint8_t>
+toForeignDelta(const std::vector<uint8_t>& pkt, const std::vector<uint8_t>& ref)
+{
+  std::vector<uint8_t> frame(IMC::c_delta_header_size, 0);
+  uint16_t length = 0;
+  putForeign(IMC::c_delta_sync, &frame[0]);
+
+  if (pkt.empty())
+  {
+    putForeign(IMC::c_delta_marker_id, &frame[2]);
+  }
+  else
+  {
+    // Identifier, source and source entity as in the packet.
+    std::copy(pkt.begin() + 2, pkt.begin() + 4, frame.begin() + 2);
+    std::copy(pkt.begin() + 14, pkt.begin() + 17, frame.begin() + 4);
+
+    // One literal run with the whole packet.
+    frame.push_back(pkt.size() - 1);
+    for (size_t i = 0; i < pkt.size(); ++i)
+      frame.push_back(pkt[i] ^ ref[i]);
+    length = pkt.size() + 1;
+  }
+
+  putForeign(length, &frame[7]);
+  return frame;
+}
+
+int
+main(void)
+{
+  Test test("IMC Delta Encoding");
+
+  std::vector<IMC::Message*> msgs;
+  for (unsigned i = 0; i < 50; ++i)
+  {
+    IMC::EulerAngles* ea = new IMC::EulerAngles;
+    ea->setTimeStamp(1000.0 + i * 0.1);
+    ea->setSource(0x8001);
+    ea->setSourceEntity(10);
+    ea->phi = 0.01 * i;
+    ea->theta = -0.02;
+    ea->psi = 1.5 + 0.001 * i;
+    ea->time = i;
+    msgs.push_back(ea);
+
+    IMC::EntityState* es = new IMC::EntityState;
+    es->setTimeStamp(1000.0 + i * 0.1);
+    es->setSource(0x8001);
+    es->setSourceEntity(20 + (i % 2));
+    es->state = IMC::EntityState::ESTA_NORMAL;
+    es->description = (i % 7) ? "active" : "idle";
+    msgs.push_back(es);
+  }
+
+  std::ostringstream plain;
+  std::ostringstream delta;
+  Utils::ByteBuffer bfr;
+  IMC::DeltaEncoder encoder(10);
+  unsigned deltas = 0;
+
+  encoder.writeMarker(bfr);
+  write(delta, bfr);
+  for (size_t i = 0; i < msgs.size(); ++i)
+  {
+    IMC::Packet::serialize(msgs[i], bfr);
+    write(plain, bfr);
+
+    if (encoder.encode(msgs[i], bfr))
+      ++deltas;
+    write(delta, bfr);
+  }
+
+  test.boolean("delta frames produced", deltas > 0);
+  test.boolean("encoded log is smaller", delta.str().size() < plain.str().size() * 3 / 4);
+
+  {
+    std::istringstream is(delta.str());
+    bool equal = true;
+    size_t count = 0;
+    IMC::Message* msg = NULL;
+    while ((msg = IMC::Packet::deserialize(is)) != NULL)
+    {
+      equal = equal && count < msgs.size() && *msg == *msgs[count];
+      ++count;
+      delete msg;
+    }
+
+    test.boolean("lossless decoding", equal && count == msgs.size());
+  }
+
+  {
+    // Start reading after the marker and the first keyframes.
+    std::string data = delta.str();
+    std::istringstream head(data);
+    Utils::ByteBuffer pkt;
+    for (unsigned i = 0; i < 4; ++i)
+      delete IMC::Packet::deserialize(head, pkt);
+
+    std::istringstream is(data.substr((size_t)head.tellg()));
+    size_t count = 0;
+    IMC::Message* msg = NULL;
+    while ((msg = IMC::Packet::deserialize(is)) != NULL)
+    {
+      ++count;
+      delete msg;
+    }
+
+    test.boolean("delta frames without marker are skipped", count > 0 && count < msgs.size());
+  }
+
+  {
+    IMC::Heartbeat first;
+    first.setTimeStamp(1000.0);
+    first.setSource(0x8001);
+    IMC::Heartbeat second(first);
+    second.setTimeStamp(1000.5);
+
+    std::vector<uint8_t> key = toForeign(&first);
+    std::vector<uint8_t> marker = toForeignDelta(std::vector<uint8_t>(), key);
+    std::vector<uint8_t> delta = toForeignDelta(toForeign(&second), key);
+
+    std::string data(marker.begin(), marker.end());
+    data.append(key.begin(), key.end());
+    data.append(delta.begin(), delta.end());
+
+    std::istringstream is(data);
+    IMC::Message* a = IMC::Packet::deserialize(is);
+    IMC::Message* b = IMC::Packet::deserialize(is);
+    test.boolean("delta frames in the other byte order",
+                 a != NULL && b != NULL && *a == first && *b == second);
+    delete a;
+    delete b;
+  }
+
+  for (size_t i = 0; i < msgs.size(); ++i)
+    delete msgs[i];
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,120 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/IMC/Definitions.hpp>
+#include <DUNE/IMC/DuplicateFilter.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+int
+main(void)
+{
+  Test test("IMC Duplicate Filter");
+
+  IMC::DuplicateFilter filter(5.0, 3);
+
+  IMC::EulerAngles ea;
+  ea.setTimeStamp(1000.0);
+  ea.setSource(0x8001);
+  ea.setSourceEntity(10);
+  ea.psi = 1.5;
+
+  test.boolean("first copy accepted", filter.accept(&ea, 0.0));
+  test.boolean("second copy dropped", !filter.accept(&ea, 1.0));
+
+  // Destination is not part of the identity of a message.
+  IMC::EulerAngles relayed = ea;
+  relayed.setDestination(0x8002);
+  test.boolean("relayed copy dropped", !filter.accept(&relayed, 1.5));
+
+  IMC::EulerAngles other = ea;
+  other.psi = 1.6;
+  test.boolean("different payload accepted", filter.accept(&other, 2.0));
+
+  other = ea;
+  other.setTimeStamp(1000.1);
+  test.boolean("different timestamp accepted", filter.accept(&other, 2.0));
+
+  other = ea;
+  other.setSourceEntity(11);
+  test.boolean("different source entity accepted", filter.accept(&other, 2.0));
+
+  test.boolean("capacity is enforced", filter.size() == 3);
+  test.boolean("oldest forgotten over capacity", filter.accept(&ea, 2.5));
+
+  test.boolean("copy dropped within window", !filter.accept(&ea, 7.0));
+  test.boolean("copy accepted after window", filter.accept(&ea, 7.5));
+
+  test.boolean("duplicates counted", filter.getDuplicateCount() == 3);
+
+  filter.clear();
+  test.boolean("cleared", filter.size() == 0 && filter.accept(&ea, 8.0));
+
+  // Links without timestamps match copies on their content.
+  IMC::DuplicateFilter links(5.0, 16);
+  std::vector<uint8_t> payload(ea.getPayloadSerializationSize());
+  ea.serializeFields(&payload[0]);
+
+  test.boolean("wire payload accepted", links.accept(&ea, &payload[0], payload.size(), 0.0));
+  test.boolean("wire payload matches serialized copy", !links.accept(&ea, 0.5));
+
+  IMC::EulerAngles radio = ea;
+  radio.setTimeStamp(2000.0);
+  radio.setSourceEntity(255);
+  test.boolean("untimed copy of timed message dropped",
+               !links.acceptUntimed(&radio, &payload[0], payload.size(), 1, 1.0));
+  test.boolean("repeat over same untimed link accepted",
+               links.acceptUntimed(&radio, &payload[0], payload.size(), 1, 1.5));
+  test.boolean("untimed copy over another link dropped",
+               !links.acceptUntimed(&radio, &payload[0], payload.size(), 2, 2.0));
+
+  other = ea;
+  other.psi = 2.5;
+  std::vector<uint8_t> other_payload(other.getPayloadSerializationSize());
+  other.serializeFields(&other_payload[0]);
+  test.boolean("untimed message accepted first",
+               links.acceptUntimed(&other, &other_payload[0], other_payload.size(), 1, 3.0));
+  test.boolean("timed copy of untimed message dropped",
+               !links.accept(&other, &other_payload[0], other_payload.size(), 3.5));
+  other.setTimeStamp(1001.0);
+  test.boolean("next timed message with same content accepted",
+               links.accept(&other, &other_payload[0], other_payload.size(), 4.0));
+
+  test.boolean("untimed copy accepted after window",
+               links.acceptUntimed(&radio, &payload[0], payload.size(), 2, 7.5));
+
+  return test.getReturnValue();
+}
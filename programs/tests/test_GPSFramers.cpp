@@ -0,0 +1,233 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Task headers.
+#include <Sensors/GPS/UBX.hpp>
+#include <Sensors/GPS/SBF.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+using Sensors::GPS::UBX;
+using Sensors::GPS::SBF;
+
+//! Reference CRC-16-CCITT (polynomial 0x1021, zero initial value).
+static uint16_t
+crc16(const uint8_t* data, size_t size)
+{
+  uint16_t crc = 0;
+  for (size_t i = 0; i < size; ++i)
+  {
+    for (unsigned j = 0; j < 8; ++j)
+    {
+      bool bit = ((data[i] >> (7 - j)) & 1) != ((crc >> 15) & 1);
+      crc <<= 1;
+      if (bit)
+        crc ^= 0x1021;
+    }
+  }
+
+  return crc;
+}
+
+//! Build a UBX frame.
+static std::vector<uint8_t>
+makeUBX(uint8_t cls, uint8_t id, const std::vector<uint8_t>& payload)
+{
+  std::vector<uint8_t> frame;
+  frame.push_back(0xB5);
+  frame.push_back(0x62);
+  frame.push_back(cls);
+  frame.push_back(id);
+  frame.push_back(payload.size() & 0xff);
+  frame.push_back(payload.size() >> 8);
+  frame.insert(frame.end(), payload.begin(), payload.end());
+
+  uint8_t a = 0;
+  uint8_t b = 0;
+  for (size_t i = 2; i < frame.size(); ++i)
+  {
+    a += frame[i];
+    b += a;
+  }
+
+  frame.push_back(a);
+  frame.push_back(b);
+  return frame;
+}
+
+//! Build an SBF block with a payload padded to a multiple of four.
+static std::vector<uint8_t>
+makeSBF(uint16_t id, size_t payload_size)
+{
+  size_t size = SBF::c_header_size + payload_size;
+  std::vector<uint8_t> block(size, 0);
+  block[0] = '$';
+  block[1] = '@';
+  block[4] = id & 0xff;
+  block[5] = id >> 8;
+  block[6] = size & 0xff;
+  block[7] = size >> 8;
+  for (size_t i = SBF::c_header_size; i < size; ++i)
+    block[i] = (uint8_t)(i * 7);
+
+  uint16_t crc = crc16(&block[4], size - 4);
+  block[2] = crc & 0xff;
+  block[3] = crc >> 8;
+  return block;
+}
+
+//! Feed bytes to a framer.
+//! @return number of complete frames.
+template <typename Framer>
+static unsigned
+feed(Framer& framer, const std::vector<uint8_t>& data, std::vector<unsigned>* ids = NULL)
+{
+  unsigned count = 0;
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    if (framer.parse(data[i]))
+    {
+      ++count;
+      if (ids != NULL)
+        ids->push_back(framer.getId());
+    }
+  }
+
+  return count;
+}
+
+static void
+append(std::vector<uint8_t>& dst, const std::vector<uint8_t>& src)
+{
+  dst.insert(dst.end(), src.begin(), src.end());
+}
+
+int
+main(void)
+{
+  Test test("GPS Binary Framers");
+
+  std::vector<uint8_t> payload(4, 0x11);
+
+  {
+    UBX ubx;
+    std::vector<uint8_t> frame = makeUBX(UBX::c_class_nav, UBX::c_nav_pvt, payload);
+    test.boolean("UBX frame with valid checksum", feed(ubx, frame) == 1);
+    test.boolean("UBX class, identifier and payload",
+                 ubx.getClass() == UBX::c_class_nav && ubx.getId() == UBX::c_nav_pvt
+                 && ubx.getPayloadSize() == payload.size()
+                 && std::memcmp(ubx.getPayload(), &payload[0], payload.size()) == 0);
+
+    frame[frame.size() - 1] ^= 0x01;
+    test.boolean("UBX frame with bad checksum dropped", feed(ubx, frame) == 0);
+  }
+
+  {
+    UBX ubx;
+    std::vector<uint8_t> frame = makeUBX(UBX::c_class_nav, UBX::c_nav_dop, payload);
+    std::vector<uint8_t> first(frame.begin(), frame.begin() + 5);
+    std::vector<uint8_t> second(frame.begin() + 5, frame.end());
+    test.boolean("UBX frame split across chunks",
+                 feed(ubx, first) == 0 && feed(ubx, second) == 1);
+  }
+
+  {
+    // A bogus header claims enough length to swallow the next frames.
+    UBX ubx;
+    std::vector<uint8_t> data;
+    const uint8_t bogus[] = {0x00, 0xB5, 0x62, 0x01, 0x07, 0x0C, 0x00};
+    data.insert(data.end(), bogus, bogus + sizeof(bogus));
+    append(data, makeUBX(UBX::c_class_nav, UBX::c_nav_att, std::vector<uint8_t>()));
+    append(data, makeUBX(UBX::c_class_nav, UBX::c_nav_dop, std::vector<uint8_t>()));
+    append(data, makeUBX(UBX::c_class_nav, UBX::c_nav_pvt, payload));
+
+    std::vector<unsigned> ids;
+    feed(ubx, data, &ids);
+    test.boolean("UBX resync keeps every frame",
+                 ids.size() == 3 && ids[0] == UBX::c_nav_att
+                 && ids[1] == UBX::c_nav_dop && ids[2] == UBX::c_nav_pvt);
+  }
+
+  {
+    const char* check = "123456789";
+    test.boolean("reference CRC-16-CCITT",
+                 crc16((const uint8_t*)check, std::strlen(check)) == 0x31C3);
+
+    SBF sbf;
+    std::vector<uint8_t> block = makeSBF(SBF::c_pvt_geodetic, 16);
+    test.boolean("SBF block with valid CRC", feed(sbf, block) == 1);
+    test.boolean("SBF block identifier and size",
+                 sbf.getId() == SBF::c_pvt_geodetic && sbf.getBlock() == block);
+
+    block[SBF::c_header_size] ^= 0x01;
+    test.boolean("SBF block with bad CRC dropped", feed(sbf, block) == 0);
+
+    std::vector<uint8_t> odd = makeSBF(SBF::c_dop, 16);
+    odd[6] = 18;
+    test.boolean("SBF block with invalid length dropped", feed(sbf, odd) == 0);
+  }
+
+  {
+    SBF sbf;
+    std::vector<uint8_t> block = makeSBF(SBF::c_dop, 8);
+    std::vector<uint8_t> first(block.begin(), block.begin() + 3);
+    std::vector<uint8_t> second(block.begin() + 3, block.begin() + 10);
+    std::vector<uint8_t> third(block.begin() + 10, block.end());
+    test.boolean("SBF block split across chunks",
+                 feed(sbf, first) == 0 && feed(sbf, second) == 0 && feed(sbf, third) == 1);
+  }
+
+  {
+    // A corrupted block hides the start of the next ones.
+    SBF sbf;
+    std::vector<uint8_t> data = makeSBF(SBF::c_receiver_time, 24);
+    data[3] ^= 0xff;
+    data.resize(12);
+    append(data, makeSBF(SBF::c_dop, 8));
+    append(data, makeSBF(SBF::c_att_euler, 8));
+    append(data, makeSBF(SBF::c_pvt_geodetic, 8));
+
+    std::vector<unsigned> ids;
+    feed(sbf, data, &ids);
+    test.boolean("SBF resync keeps every block",
+                 ids.size() == 3 && ids[0] == SBF::c_dop
+                 && ids[1] == SBF::c_att_euler && ids[2] == SBF::c_pvt_geodetic);
+  }
+
+  return test.getReturnValue();
+}
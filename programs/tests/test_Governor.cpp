@@ -0,0 +1,151 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <string>
+
+// DUNE headers.
+#include <DUNE/Tasks/Context.hpp>
+#include <DUNE/Tasks/Factory.hpp>
+#include <DUNE/Tasks/Manager.hpp>
+#include <DUNE/Tasks/Periodic.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE;
+
+//! Periodic task that does nothing but count its executions.
+struct Sampler: public Tasks::Periodic
+{
+  //! Last instance created by the task manager.
+  static Sampler* s_last;
+
+  Sampler(const std::string& name, Tasks::Context& ctx):
+    Tasks::Periodic(name, ctx)
+  {
+    s_last = this;
+  }
+
+  void
+  task(void)
+  { }
+};
+
+Sampler* Sampler::s_last = NULL;
+
+static Tasks::Task*
+createSampler(const std::string& name, Tasks::Context& ctx)
+{
+  return new Sampler(name, ctx);
+}
+
+//! Count executions of a task driven inline for some time.
+static unsigned
+countRuns(Sampler* task, double& now, double duration)
+{
+  unsigned count = 0;
+  for (double end = now + duration; now < end; now += 0.001)
+  {
+    if (task->stepInline(now))
+      ++count;
+  }
+
+  return count;
+}
+
+//! Check if a run count matches the expected one, allowing for the
+//! executions at the boundaries of a frequency change.
+static bool
+near(unsigned count, unsigned expected)
+{
+  return count + 3 >= expected && count <= expected + 3;
+}
+
+//! Configure a sampler running at 10 Hz.
+static void
+configure(Tasks::Context& ctx, const std::string& criticality, const std::string& min_frequency)
+{
+  ctx.config.set("Test.Sampler", "Enabled", "Always");
+  ctx.config.set("Test.Sampler", "Entity Label", "Sampler");
+  ctx.config.set("Test.Sampler", "Execution Frequency", "10");
+  ctx.config.set("Test.Sampler", "Criticality", criticality);
+  ctx.config.set("Test.Sampler", "Minimum Execution Frequency", min_frequency);
+}
+
+int
+main(void)
+{
+  Test test("Task Rate Governor");
+
+  Tasks::Factory::registerStaticTask("Test.Sampler", createSampler);
+
+  {
+    Tasks::Context ctx;
+    configure(ctx, "Low", "0");
+    Tasks::Manager man(ctx);
+
+    test.boolean("idle when no task can be throttled",
+                 man.governRates(true, false) == 0);
+  }
+
+  {
+    Tasks::Context ctx;
+    configure(ctx, "High", "2");
+    Tasks::Manager man(ctx);
+
+    test.boolean("idle when only critical tasks have a minimum",
+                 man.governRates(true, false) == 0);
+  }
+
+  {
+    Tasks::Context ctx;
+    configure(ctx, "Low", "2");
+    Tasks::Manager man(ctx);
+    Sampler* task = Sampler::s_last;
+    double now = 0.0;
+
+    test.boolean("task can be throttled", task->isThrottleable());
+    test.boolean("nominal frequency", near(countRuns(task, now, 10.0), 100));
+
+    man.governRates(true, false);
+    test.boolean("escalates under overload", man.governRates(true, false) == 2);
+    test.boolean("frequency drops", near(countRuns(task, now, 10.0), 25));
+
+    man.governRates(true, false);
+    man.governRates(true, false);
+    test.boolean("frequency bounded by minimum", near(countRuns(task, now, 10.0), 20));
+
+    for (unsigned i = 0; i < 4; ++i)
+      man.governRates(false, true);
+    test.boolean("frequency restored", near(countRuns(task, now, 10.0), 100));
+  }
+
+  return test.getReturnValue();
+}
@@ -31,7 +31,10 @@
 #include <iostream>
 
 // DUNE headers.
+#include <DUNE/IO/Poll.hpp>
 #include <DUNE/Network.hpp>
+#include <DUNE/Network/ReceiveTime.hpp>
+#include <DUNE/Time.hpp>
 
 // Local headers.
 #include "Test.hpp"
@@ -86,5 +89,32 @@ main(void)
     test.boolean("IP address resolution", a.resolve());
   }
 
-  return 0;
+  // Address tests depend on external name resolution and are
+  // informative only.
+  Test udp("Network::UDPSocket");
+
+  {
+    UDPSocket rx;
+    UDPSocket tx;
+    rx.bind(0, Address::Loopback);
+    uint16_t port = rx.getBoundPort();
+
+#if defined(DUNE_SOCKET_RX_TIMESTAMPS)
+    udp.boolean("UDP receive time stamps enabled", rx.enableReceiveTimestamps(true));
+#endif
+
+    const uint8_t data[] = {0x01, 0x02, 0x03};
+    double sent = DUNE::Time::Clock::getSinceEpoch();
+    tx.write(data, sizeof(data), Address::Loopback, port);
+
+    uint8_t bfr[16];
+    udp.boolean("UDP datagram received", DUNE::IO::Poll::poll(rx, 5.0)
+                && rx.read(bfr, sizeof(bfr)) == sizeof(data));
+    double read = DUNE::Time::Clock::getSinceEpoch();
+    double stamp = rx.getLastReadTime();
+
+    udp.boolean("UDP receive time stamp", sent <= stamp && stamp <= read);
+  }
+
+  return udp.getReturnValue();
 }
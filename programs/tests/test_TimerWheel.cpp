@@ -0,0 +1,86 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/TimerWheel.hpp>
+
+// Local headers.
+#include "Test.hpp"
+
+using namespace DUNE::Time;
+
+int
+main(void)
+{
+  Test test("Time::TimerWheel");
+
+  TimerWheel::clear();
+  TimerWheel::setGranularity(0.01);
+
+  double base = std::floor(Clock::get()) + 100.0;
+
+  {
+    double deadline = base + 0.0042;
+    test.boolean("no slack keeps deadline", TimerWheel::schedule(deadline, 0.0) == deadline);
+  }
+
+  {
+    double deadline = base + 0.0013;
+    test.boolean("joins pending wake-up", TimerWheel::schedule(deadline, 0.005) == base + 0.0042);
+  }
+
+  {
+    double deadline = base + 1.0013;
+    double wake = TimerWheel::schedule(deadline, 0.05);
+    test.boolean("aligned to slot", wake >= deadline && wake <= deadline + 0.05
+                 && wake - deadline < 0.01);
+    test.boolean("second task shares slot", TimerWheel::schedule(base + 1.0021, 0.05) == wake);
+  }
+
+  {
+    double deadline = base + 2.0001;
+    test.boolean("small slack keeps deadline", TimerWheel::schedule(deadline, 0.001) == deadline);
+  }
+
+  {
+    double deadline = base + 3.0;
+    double wake = TimerWheel::schedule(deadline, 0.02);
+    test.boolean("never early", wake >= deadline);
+  }
+
+  test.boolean("pending", TimerWheel::getPending() == 4);
+  TimerWheel::clear();
+  test.boolean("clear()", TimerWheel::getPending() == 0);
+
+  return test.getReturnValue();
+}
@@ -0,0 +1,636 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+// Utility to maintain a catalog of LSF logs and query it.                  *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+using DUNE_NAMESPACES;
+
+//! Minimum interval between track points (s).
+static const double c_track_period = 10.0;
+//! Number of logs between progress reports.
+static const unsigned c_progress = 50;
+
+//! Catalog schema.
+static const char* c_schema[] =
+{
+  "CREATE TABLE IF NOT EXISTS LOGS (ID INTEGER PRIMARY KEY, PATH TEXT UNIQUE NOT NULL, "
+  "SIZE REAL, MTIME REAL, SYSTEM TEXT, START REAL, END REAL, "
+  "LAT_MIN REAL, LON_MIN REAL, LAT_MAX REAL, LON_MAX REAL, "
+  "MESSAGES INTEGER, CONFIG TEXT, COMPLETE INTEGER)",
+  "CREATE TABLE IF NOT EXISTS TRACK (LOG INTEGER NOT NULL, TIME REAL, "
+  "LAT REAL, LON REAL, DEPTH REAL)",
+  "CREATE TABLE IF NOT EXISTS COUNTS (LOG INTEGER NOT NULL, NAME TEXT, COUNT INTEGER)",
+  "CREATE TABLE IF NOT EXISTS ERRORS (LOG INTEGER NOT NULL, TIME REAL, "
+  "ENTITY TEXT, DESCRIPTION TEXT)",
+  "CREATE TABLE IF NOT EXISTS ACTIVITY (LOG INTEGER NOT NULL, ENTITY TEXT, SECONDS REAL)",
+  "CREATE INDEX IF NOT EXISTS TRACK_LOG ON TRACK (LOG)",
+  "CREATE INDEX IF NOT EXISTS TRACK_POS ON TRACK (LAT, LON)",
+  "CREATE INDEX IF NOT EXISTS COUNTS_NAME ON COUNTS (NAME)",
+  "CREATE INDEX IF NOT EXISTS ERRORS_ENTITY ON ERRORS (ENTITY)",
+  "CREATE INDEX IF NOT EXISTS ACTIVITY_ENTITY ON ACTIVITY (ENTITY)",
+  NULL
+};
+
+//! Tables with per log rows.
+static const char* c_log_tables[] = {"TRACK", "COUNTS", "ERRORS", "ACTIVITY", NULL};
+
+//! Entity error.
+struct EntityError
+{
+  //! Time of the error.
+  double time;
+  //! Entity key (source and entity).
+  unsigned key;
+  //! Description.
+  std::string description;
+};
+
+//! Summary of a log.
+struct Summary
+{
+  //! System that produced the log.
+  std::string system;
+  //! Time of first and last messages.
+  double start, end;
+  //! Bounding box (degrees).
+  double lat_min, lon_min, lat_max, lon_max;
+  //! Number of messages.
+  unsigned messages;
+  //! True if the whole log was read.
+  bool complete;
+  //! Configuration fingerprint.
+  std::string config;
+  //! Decimated track (time, lat, lon, depth).
+  std::vector<std::vector<double> > track;
+  //! Messages per type.
+  std::map<std::string, unsigned> counts;
+  //! Entity errors.
+  std::vector<EntityError> errors;
+  //! Active time per entity key.
+  std::map<unsigned, double> activity;
+  //! Entity labels per entity key.
+  std::map<unsigned, std::string> labels;
+
+  Summary(void):
+    start(-1.0),
+    end(-1.0),
+    lat_min(90.0),
+    lon_min(180.0),
+    lat_max(-90.0),
+    lon_max(-180.0),
+    messages(0),
+    complete(false)
+  { }
+
+  std::string
+  label(unsigned key) const
+  {
+    std::map<unsigned, std::string>::const_iterator itr = labels.find(key);
+    if (itr != labels.end())
+      return itr->second;
+
+    return String::str("%u:%u", key >> 8, key & 0xff);
+  }
+};
+
+static unsigned
+entityKey(const IMC::Message* msg)
+{
+  return (msg->getSource() << 8) | msg->getSourceEntity();
+}
+
+static std::string
+fingerprint(const Path& path)
+{
+  if (!path.isFile())
+    return "";
+
+  uint8_t digest[16];
+  Algorithms::MD5::compute(path.c_str(), digest);
+
+  std::string rv;
+  for (unsigned i = 0; i < 16; ++i)
+    rv += String::str("%02x", digest[i]);
+
+  return rv;
+}
+
+//! Extract the summary of a log.
+static void
+summarize(const Path& data, Summary& sum)
+{
+  std::istream* is = 0;
+  Compression::Methods method = Compression::Factory::detect(data.c_str());
+  if (method == METHOD_UNKNOWN)
+    is = new std::ifstream(data.c_str(), std::ios::binary);
+  else
+    is = new Compression::FileInput(data.c_str(), method);
+
+  // System that produced the log, unknown until LoggingControl is read.
+  unsigned sys_id = UINT_MAX;
+  double last_point = -1.0;
+  // Start of activation per entity key.
+  std::map<unsigned, double> active_since;
+  // Last error description per entity key.
+  std::map<unsigned, std::string> in_error;
+
+  IMC::Message* msg = NULL;
+
+  try
+  {
+    while ((msg = IMC::Packet::deserialize(*is)) != 0)
+    {
+      double time = msg->getTimeStamp();
+      if (sum.start < 0.0)
+        sum.start = time;
+      sum.end = std::max(sum.end, time);
+      ++sum.messages;
+      ++sum.counts[msg->getName()];
+
+      bool own = (sys_id == UINT_MAX || msg->getSource() == sys_id);
+
+      switch (msg->getId())
+      {
+        case DUNE_IMC_LOGGINGCONTROL:
+          if (sys_id == UINT_MAX
+              && static_cast<IMC::LoggingControl*>(msg)->op == IMC::LoggingControl::COP_STARTED)
+            sys_id = msg->getSource();
+          break;
+
+        case DUNE_IMC_ANNOUNCE:
+          if (msg->getSource() == sys_id)
+            sum.system = static_cast<IMC::Announce*>(msg)->sys_name;
+          break;
+
+        case DUNE_IMC_ENTITYINFO:
+          {
+            IMC::EntityInfo* info = static_cast<IMC::EntityInfo*>(msg);
+            sum.labels[(msg->getSource() << 8) | info->id] = info->label;
+          }
+          break;
+
+        case DUNE_IMC_ESTIMATEDSTATE:
+          if (own)
+          {
+            IMC::EstimatedState* state = static_cast<IMC::EstimatedState*>(msg);
+
+            // Navigation without a position reference.
+            if (state->lat == 0.0 && state->lon == 0.0)
+              break;
+
+            double lat, lon;
+            Coordinates::toWGS84(*state, lat, lon);
+            lat = Angles::degrees(lat);
+            lon = Angles::degrees(lon);
+
+            sum.lat_min = std::min(sum.lat_min, lat);
+            sum.lat_max = std::max(sum.lat_max, lat);
+            sum.lon_min = std::min(sum.lon_min, lon);
+            sum.lon_max = std::max(sum.lon_max, lon);
+
+            if (time - last_point >= c_track_period)
+            {
+              std::vector<double> point(4);
+              point[0] = time;
+              point[1] = lat;
+              point[2] = lon;
+              point[3] = state->depth;
+              sum.track.push_back(point);
+              last_point = time;
+            }
+          }
+          break;
+
+        case DUNE_IMC_ENTITYSTATE:
+          if (own)
+          {
+            IMC::EntityState* state = static_cast<IMC::EntityState*>(msg);
+            unsigned key = entityKey(msg);
+            bool error = (state->state == IMC::EntityState::ESTA_ERROR
+                          || state->state == IMC::EntityState::ESTA_FAILURE);
+
+            if (!error)
+            {
+              in_error.erase(key);
+            }
+            else if (in_error[key] != state->description)
+            {
+              in_error[key] = state->description;
+              EntityError err;
+              err.time = time;
+              err.key = key;
+              err.description = state->description;
+              sum.errors.push_back(err);
+            }
+          }
+          break;
+
+        case DUNE_IMC_ENTITYACTIVATIONSTATE:
+          if (own)
+          {
+            IMC::EntityActivationState* eas = static_cast<IMC::EntityActivationState*>(msg);
+            unsigned key = entityKey(msg);
+            bool active = (eas->state == IMC::EntityActivationState::EAS_ACTIVE
+                           || eas->state == IMC::EntityActivationState::EAS_ACT_DONE
+                           || eas->state == IMC::EntityActivationState::EAS_DEACT_IP);
+
+            std::map<unsigned, double>::iterator itr = active_since.find(key);
+            if (active && itr == active_since.end())
+            {
+              active_since[key] = time;
+            }
+            else if (!active && itr != active_since.end())
+            {
+              sum.activity[key] += time - itr->second;
+              active_since.erase(itr);
+            }
+          }
+          break;
+      }
+
+      delete msg;
+    }
+
+    sum.complete = true;
+  }
+  catch (std::runtime_error& e)
+  {
+    std::cerr << "WARNING: " << data.str() << ": " << e.what() << std::endl;
+  }
+
+  std::map<unsigned, double>::iterator itr = active_since.begin();
+  for (; itr != active_since.end(); ++itr)
+    sum.activity[itr->first] += sum.end - itr->second;
+
+  if (sum.system.empty() && sys_id != UINT_MAX)
+    sum.system = String::str("%u", sys_id);
+
+  delete is;
+}
+
+//! Find the data file of a log folder.
+static Path
+findData(const Path& folder)
+{
+  const char* names[] = {"Data.lsf.gz", "Data.lsf.bz2", "Data.lsf", NULL};
+  for (unsigned i = 0; names[i] != NULL; ++i)
+  {
+    Path data = folder / names[i];
+    if (data.isFile())
+      return data;
+  }
+
+  return Path();
+}
+
+//! Recursively find log folders.
+static void
+findLogs(const Path& root, std::vector<Path>& logs)
+{
+  if (!findData(root).empty())
+  {
+    logs.push_back(root);
+    return;
+  }
+
+  std::vector<Path> entries;
+  root.contents(entries);
+  std::sort(entries.begin(), entries.end());
+
+  for (unsigned i = 0; i < entries.size(); ++i)
+  {
+    if (entries[i].isDirectory() && !entries[i].isLink())
+      findLogs(entries[i], logs);
+  }
+}
+
+static void
+createSchema(Database::Connection& db)
+{
+  for (unsigned i = 0; c_schema[i] != NULL; ++i)
+    db.execute(c_schema[i]);
+}
+
+static void
+removeLog(Database::Connection& db, int id)
+{
+  for (unsigned i = 0; c_log_tables[i] != NULL; ++i)
+  {
+    Database::Statement del(String::str("DELETE FROM %s WHERE LOG = ?", c_log_tables[i]).c_str(), db);
+    del << id;
+    del.execute();
+  }
+
+  Database::Statement del("DELETE FROM LOGS WHERE ID = ?", db);
+  del << id;
+  del.execute();
+}
+
+//! Index a log folder.
+//! @return true if the log was (re)indexed, false if it was up to date.
+static bool
+indexLog(Database::Connection& db, const Path& folder)
+{
+  Path data = findData(folder);
+  std::string path = folder.str();
+  double size = (double)data.size();
+  double mtime = (double)data.getLastModifiedTime();
+
+  int old_id = -1;
+  Database::Statement find("SELECT ID, SIZE, MTIME FROM LOGS WHERE PATH = ?", db);
+  find << path;
+  if (find.execute())
+  {
+    double old_size, old_mtime;
+    find >> old_id >> old_size >> old_mtime;
+    find.reset();
+
+    if (old_size == size && old_mtime == mtime)
+      return false;
+  }
+
+  Summary sum;
+  summarize(data, sum);
+  sum.config = fingerprint(folder / "Config.ini");
+
+  db.beginTransaction();
+
+  // Replace the previous entry atomically.
+  try
+  {
+    if (old_id >= 0)
+      removeLog(db, old_id);
+
+    Database::Statement insert("INSERT INTO LOGS (PATH, SIZE, MTIME, SYSTEM, START, END, "
+                               "LAT_MIN, LON_MIN, LAT_MAX, LON_MAX, MESSAGES, CONFIG, COMPLETE) "
+                               "VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?)", db);
+    insert << path << size << mtime << sum.system << sum.start << sum.end;
+
+    if (sum.track.empty())
+      insert << Database::Null() << Database::Null() << Database::Null() << Database::Null();
+    else
+      insert << sum.lat_min << sum.lon_min << sum.lat_max << sum.lon_max;
+
+    insert << (int)sum.messages << sum.config << (int)sum.complete;
+    insert.execute();
+
+    int id = 0;
+    find << path;
+    if (find.execute())
+    {
+      find >> id;
+      find.reset();
+    }
+
+    Database::Statement track("INSERT INTO TRACK VALUES (?,?,?,?,?)", db);
+    for (unsigned i = 0; i < sum.track.size(); ++i)
+    {
+      track << id << sum.track[i][0] << sum.track[i][1] << sum.track[i][2] << sum.track[i][3];
+      track.execute();
+    }
+
+    Database::Statement counts("INSERT INTO COUNTS VALUES (?,?,?)", db);
+    std::map<std::string, unsigned>::const_iterator citr = sum.counts.begin();
+    for (; citr != sum.counts.end(); ++citr)
+    {
+      counts << id << citr->first << (int)citr->second;
+      counts.execute();
+    }
+
+    Database::Statement errors("INSERT INTO ERRORS VALUES (?,?,?,?)", db);
+    for (unsigned i = 0; i < sum.errors.size(); ++i)
+    {
+      errors << id << sum.errors[i].time << sum.label(sum.errors[i].key) << sum.errors[i].description;
+      errors.execute();
+    }
+
+    Database::Statement activity("INSERT INTO ACTIVITY VALUES (?,?,?)", db);
+    std::map<unsigned, double>::const_iterator aitr = sum.activity.begin();
+    for (; aitr != sum.activity.end(); ++aitr)
+    {
+      activity << id << sum.label(aitr->first) << aitr->second;
+      activity.execute();
+    }
+
+    db.commit();
+  }
+  catch (...)
+  {
+    db.rollback();
+    throw;
+  }
+
+  return true;
+}
+
+static int
+commandIndex(Database::Connection& db, int argc, char** argv)
+{
+  std::vector<Path> logs;
+  for (int i = 0; i < argc; ++i)
+    findLogs(Path(argv[i]), logs);
+
+  unsigned indexed = 0;
+  for (unsigned i = 0; i < logs.size(); ++i)
+  {
+    try
+    {
+      if (indexLog(db, logs[i]))
+        ++indexed;
+    }
+    catch (std::runtime_error& e)
+    {
+      std::cerr << "ERROR: " << logs[i].str() << ": " << e.what() << std::endl;
+    }
+
+    if ((i + 1) % c_progress == 0)
+      std::cerr << (i + 1) << "/" << logs.size() << " logs" << std::endl;
+  }
+
+  std::cout << "found " << logs.size() << " logs, indexed " << indexed
+            << ", " << (logs.size() - indexed) << " up to date" << std::endl;
+
+  return 0;
+}
+
+static int
+commandArea(Database::Connection& db, int argc, char** argv)
+{
+  if (argc != 4)
+    return -1;
+
+  double lat_min = std::atof(argv[0]);
+  double lon_min = std::atof(argv[1]);
+  double lat_max = std::atof(argv[2]);
+  double lon_max = std::atof(argv[3]);
+
+  Database::Statement query("SELECT L.PATH, L.SYSTEM, MIN(T.TIME), MAX(T.TIME), MAX(T.DEPTH) "
+                            "FROM LOGS L JOIN TRACK T ON T.LOG = L.ID "
+                            "WHERE L.LAT_MAX >= ?1 AND L.LAT_MIN <= ?3 "
+                            "AND L.LON_MAX >= ?2 AND L.LON_MIN <= ?4 "
+                            "AND T.LAT BETWEEN ?1 AND ?3 AND T.LON BETWEEN ?2 AND ?4 "
+                            "GROUP BY L.ID ORDER BY L.START", db);
+  query << lat_min << lon_min << lat_max << lon_max;
+
+  while (query.execute())
+  {
+    std::string path, system;
+    double start, end, depth;
+    query >> path >> system >> start >> end >> depth;
+    std::printf("%s %s %s %.0f s, max. depth %.1f m\n", path.c_str(), system.c_str(),
+                Time::Format::getTimeDate(start).c_str(), end - start, depth);
+  }
+
+  return 0;
+}
+
+static int
+commandErrors(Database::Connection& db, int argc, char** argv)
+{
+  if (argc != 1)
+    return -1;
+
+  Database::Statement query("SELECT L.PATH, E.TIME, E.DESCRIPTION FROM ERRORS E "
+                            "JOIN LOGS L ON E.LOG = L.ID WHERE E.ENTITY = ? "
+                            "ORDER BY E.TIME", db);
+  query << std::string(argv[0]);
+
+  while (query.execute())
+  {
+    std::string path, description;
+    double time;
+    query >> path >> time >> description;
+    std::printf("%s %s %s\n", path.c_str(), Time::Format::getTimeDate(time).c_str(),
+                description.c_str());
+  }
+
+  return 0;
+}
+
+static int
+commandActive(Database::Connection& db, int argc, char** argv)
+{
+  if (argc != 1)
+    return -1;
+
+  Database::Statement query("SELECT L.SYSTEM, COUNT(*), SUM(A.SECONDS) FROM ACTIVITY A "
+                            "JOIN LOGS L ON A.LOG = L.ID WHERE A.ENTITY = ? "
+                            "GROUP BY L.SYSTEM ORDER BY L.SYSTEM", db);
+  query << std::string(argv[0]);
+
+  double total = 0.0;
+  while (query.execute())
+  {
+    std::string system;
+    int logs;
+    double seconds;
+    query >> system >> logs >> seconds;
+    std::printf("%s: %.2f h in %d logs\n", system.c_str(), seconds / 3600.0, logs);
+    total += seconds;
+  }
+
+  std::printf("total: %.2f h\n", total / 3600.0);
+
+  return 0;
+}
+
+static void
+usage(const char* name)
+{
+  std::cerr << "Usage: " << name << " <catalog.db> <command> [arguments]" << std::endl
+            << std::endl
+            << "Commands:" << std::endl
+            << "  index <folder> ...                        "
+            << "index logs found under folders, skipping unchanged ones" << std::endl
+            << "  area <lat min> <lon min> <lat max> <lon max> "
+            << "logs with track points in area (degrees)" << std::endl
+            << "  errors <entity label>                     "
+            << "errors of an entity" << std::endl
+            << "  active <entity label>                     "
+            << "time an entity was active" << std::endl
+            << std::endl
+            << "The catalog is an SQLite database with tables LOGS, TRACK, COUNTS,"
+            << std::endl
+            << "ERRORS and ACTIVITY, that can be queried with any SQLite client." << std::endl;
+}
+
+int
+main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    usage(argv[0]);
+    return 1;
+  }
+
+  int rv = -1;
+
+  try
+  {
+    Database::Connection db(argv[1], Database::Connection::CF_CREATE);
+    createSchema(db);
+
+    std::string command = argv[2];
+    if (command == "index")
+      rv = commandIndex(db, argc - 3, argv + 3);
+    else if (command == "area")
+      rv = commandArea(db, argc - 3, argv + 3);
+    else if (command == "errors")
+      rv = commandErrors(db, argc - 3, argv + 3);
+    else if (command == "active")
+      rv = commandActive(db, argc - 3, argv + 3);
+  }
+  catch (std::runtime_error& e)
+  {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+
+  if (rv < 0)
+  {
+    usage(argv[0]);
+    return 1;
+  }
+
+  return rv;
+}
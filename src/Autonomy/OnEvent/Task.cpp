@@ -320,7 +320,7 @@ namespace Autonomy
       {
         while (!stopping())
         {
-          waitForMessages(1.0);
+          waitForMessages();
         }
       }
     };
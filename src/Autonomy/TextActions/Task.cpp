@@ -608,7 +608,7 @@ namespace Autonomy
       {
         while (!stopping())
         {
-          waitForMessages(1.0);
+          waitForMessages();
         }
       }
     };
@@ -600,7 +600,7 @@ namespace Control
         {
           while (!stopping())
           {
-            waitForMessages(1.0);
+            waitForMessages();
           }
         }
       };
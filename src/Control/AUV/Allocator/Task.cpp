@@ -727,7 +727,7 @@ namespace Control
         {
           while (!stopping())
           {
-            waitForMessages(1.0);
+            waitForMessages();
           }
         }
       };
@@ -477,7 +477,7 @@ namespace Control
         {
           while (!stopping())
           {
-            waitForMessages(1.0);
+            waitForMessages();
           }
         }
       };
@@ -160,7 +160,7 @@ namespace Control
       {
         while (!stopping())
         {
-          waitForMessages(1.0);
+          waitForMessages();
         }
       }
     };
@@ -87,13 +87,11 @@ namespace DUNE
       inline bool
       waitForItems(double timeout = -1.0)
       {
-        if (empty())
-        {
-          ScopedCondition l(m_cond);
-          return m_cond.wait(timeout);
-        }
+        ScopedCondition l(m_cond);
+        if (!m_queue.empty())
+          return true;
 
-        return true;
+        return m_cond.wait(timeout);
       }
 
       //! Verify if the queue has elements.
@@ -59,6 +59,8 @@ namespace DUNE
       m_required_loops(required_loops),
       m_scope_ref(0)
     {
+      setDefaultCriticality(Tasks::CRITICALITY_HIGH);
+
       param("Heading Rate Bypass", m_hrate_bypass)
       .defaultValue("false")
       .description("Bypass heading rate controller and use reference directly on torques");
@@ -423,7 +425,7 @@ namespace DUNE
     {
       while (!stopping())
       {
-        waitForMessages(1.0);
+        waitForMessages();
       }
     }
   }
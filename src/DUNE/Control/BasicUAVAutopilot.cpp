@@ -50,6 +50,7 @@ namespace DUNE
         m_required_loops(required_loops),
         m_scope_ref(0)
     {
+      setDefaultCriticality(Tasks::CRITICALITY_HIGH);
 
       // Initialize entity state.
       setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_IDLE);
@@ -150,7 +151,7 @@ namespace DUNE
     {
       while (!stopping())
       {
-        waitForMessages(1.0);
+        waitForMessages();
       }
     }
 
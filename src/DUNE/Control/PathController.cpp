@@ -68,6 +68,8 @@ namespace DUNE
       m_btrack(NULL),
       m_scope_ref(0)
     {
+      setDefaultCriticality(Tasks::CRITICALITY_HIGH);
+
       param("Control Frequency", m_cperiod)
       .defaultValue("10")
       .description("Control frequency (< 0 for event-driven EstimatedState processing)")
@@ -1098,7 +1100,7 @@ namespace DUNE
     {
       while (!stopping())
       {
-        waitForMessages(1.0);
+        waitForMessages();
       }
     }
   }
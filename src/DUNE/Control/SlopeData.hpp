@@ -32,6 +32,7 @@
 
 // ISO C++ 98 headers.
 #include <cmath>
+#include <set>
 
 // DUNE headers.
 #include <DUNE/Math.hpp>
@@ -99,7 +100,11 @@ namespace DUNE
         m_slope_top.reset();
       }
 
-      //! Consume a Distance message
+      //! Consume a Distance message. Only sources whose beam always
+      //! points forward are used: a source that reports any other
+      //! beam direction, like a scanning sonar, is ignored from then
+      //! on, so it cannot compete with fixed forward looking sources
+      //! such as the clearance reported by obstacle detection.
       //! @param[in] msg sonar distance message
       //! @param[in] state estimatedstate message
       //! @param[in] cparcel control parcel message
@@ -107,17 +112,35 @@ namespace DUNE
       bool
       onDistance(const IMC::Distance* msg, const IMC::EstimatedState& state, IMC::ControlParcel& cparcel)
       {
+        unsigned eid = msg->getSourceEntity();
+
+        // checking first in the list only
+        if (msg->location.size() &&
+            ((std::fabs((*msg->location.begin())->psi) >= 0.1) ||
+             (std::fabs((*msg->location.begin())->theta) >= 0.1)))
+        {
+          m_scanning.insert(eid);
+
+          if (m_sonar_conf && (m_sonar_entity == eid))
+          {
+            m_sonar_conf = false;
+            Memory::clear(m_frange);
+          }
+
+          return false;
+        }
+
+        if (m_scanning.find(eid) != m_scanning.end())
+          return false;
+
         if (!m_sonar_conf && msg->location.size())
         {
           // check if it is an echo sounder and pointing forward
-          // checking first in the list only
-          if ((std::fabs((*msg->location.begin())->psi) < 0.1) &&
-              (std::fabs((*msg->location.begin())->theta) < 0.1) &&
-              msg->beam_config.size())
+          if (msg->beam_config.size())
           {
             m_beam_width = (*msg->beam_config.begin())->beam_width;
             m_sonar_conf = true;
-            m_sonar_entity = msg->getSourceEntity();
+            m_sonar_entity = eid;
 
             if (msg->validity == IMC::Distance::DV_VALID)
             {
@@ -126,7 +149,7 @@ namespace DUNE
             }
           }
         }
-        else if ((m_sonar_entity == msg->getSourceEntity()) &&
+        else if (m_sonar_conf && (m_sonar_entity == eid) &&
                  (msg->validity == IMC::Distance::DV_VALID))
         {
           update(msg->value, state, cparcel);
@@ -427,6 +450,8 @@ namespace DUNE
       bool m_sonar_conf;
       //! Sonar entity.
       unsigned m_sonar_entity;
+      //! Entities that reported beams not pointing forward.
+      std::set<unsigned> m_scanning;
       //! Echo sounder beam width.
       float m_beam_width;
       //! Time without updates.
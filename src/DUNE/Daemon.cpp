@@ -50,6 +50,7 @@ namespace DUNE
     DUNE::Tasks::Task("Daemon", ctx),
     m_tman(NULL),
     m_fs_capacity(0),
+    m_gov_level(0),
     call_reboot(false)
   {
     // Retrieve known IMC addresses.
@@ -133,6 +134,7 @@ namespace DUNE
 
     // CPU usage.
     m_ctx.config.get("General", "CPU Usage - Maximum", "65", m_cpu_max_usage);
+    m_ctx.config.get("General", "CPU Usage - Nominal", "50", m_cpu_nominal_usage);
     m_ctx.config.get("General", "CPU Usage - Moving Average Samples", "10", m_cpu_avg_samples);
     m_cpu_avg = new Math::MovingAverage<double>(m_cpu_avg_samples);
 
@@ -289,6 +291,18 @@ namespace DUNE
       {
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
       }
+
+      unsigned level = m_tman->governRates(cpu_avg >= m_cpu_max_usage,
+                                           cpu_avg < m_cpu_nominal_usage);
+      if (level != m_gov_level)
+      {
+        if (level > m_gov_level)
+          war(DTR("slowing down non-critical tasks (level %u)"), level);
+        else
+          inf(DTR("restoring non-critical tasks (level %u)"), level);
+
+        m_gov_level = level;
+      }
     }
   }
 
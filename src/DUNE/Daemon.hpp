@@ -89,6 +89,14 @@ namespace DUNE
     void
     writeParamsXML(std::ostream& os) const;
 
+    //! Retrieve the manager of the tasks run by this daemon.
+    //! @return task manager.
+    Tasks::Manager*
+    getTaskManager(void)
+    {
+      return m_tman;
+    }
+
   private:
     //! System resources.
     System::Resources m_sys_resources;
@@ -106,6 +114,11 @@ namespace DUNE
     unsigned m_cpu_avg_samples;
     //! Overall CPU usage - maximum percentage before issuing error.
     int m_cpu_max_usage;
+    //! Overall CPU usage - percentage below which throttled tasks
+    //! are restored.
+    int m_cpu_nominal_usage;
+    //! Current level of the task rate governor.
+    unsigned m_gov_level;
     //! Overall CPU usage - moving average.
     Math::MovingAverage<double>* m_cpu_avg;
     //! Signal system reboot
@@ -39,6 +39,7 @@ namespace DUNE
 
 #include <DUNE/Hardware/SerialPort.hpp>
 #include <DUNE/Hardware/I2C.hpp>
+#include <DUNE/Hardware/CANSocket.hpp>
 #include <DUNE/Hardware/IOPort.hpp>
 #include <DUNE/Hardware/GPIO.hpp>
 #include <DUNE/Hardware/Buttons.hpp>
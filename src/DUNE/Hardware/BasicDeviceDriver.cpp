@@ -156,7 +156,6 @@ namespace DUNE
     {
       initializeDevice();
       setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
-      debug("activation took %0.2f s", m_wdog.getElapsed());
     }
 
     void
@@ -0,0 +1,341 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cerrno>
+#include <cstring>
+#include <vector>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Exceptions.hpp>
+#include <DUNE/System/Error.hpp>
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/Network/ReceiveTime.hpp>
+#include <DUNE/Hardware/CANSocket.hpp>
+
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_UNISTD_H)
+#  include <unistd.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_SYS_SOCKET_H)
+#  include <sys/socket.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_SYS_IOCTL_H)
+#  include <sys/ioctl.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_NET_IF_H)
+#  include <net/if.h>
+#endif
+
+// Linux headers.
+#if defined(DUNE_SYS_HAS_LINUX_CAN_H)
+#  include <linux/can.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_LINUX_CAN_RAW_H)
+#  include <linux/can/raw.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_LINUX_CAN_H) && defined(DUNE_SYS_HAS_LINUX_CAN_RAW_H) \
+  && defined(DUNE_SYS_HAS_SYS_SOCKET_H) && defined(DUNE_SYS_HAS_NET_IF_H) \
+  && defined(DUNE_SOCKET_RX_TIMESTAMPS)
+#  define DUNE_SYS_HAS_SOCKET_CAN 1
+#endif
+
+#if defined(DUNE_SYS_HAS_SOCKET_CAN)
+//! Convert a kernel frame.
+//! @param[in] src kernel frame.
+//! @param[in] time reception time.
+//! @param[out] dst frame.
+static void
+fromNative(const can_frame& src, double time, DUNE::Hardware::CANSocket::Frame& dst)
+{
+  dst.extended = (src.can_id & CAN_EFF_FLAG) != 0;
+  dst.rtr = (src.can_id & CAN_RTR_FLAG) != 0;
+  dst.id = src.can_id & (dst.extended ? CAN_EFF_MASK : CAN_SFF_MASK);
+  dst.length = src.can_dlc > CAN_MAX_DLEN ? CAN_MAX_DLEN : src.can_dlc;
+  std::memcpy(dst.data, src.data, dst.length);
+  dst.time = (time < 0) ? DUNE::Time::Clock::getSinceEpoch() : time;
+}
+#endif
+
+namespace DUNE
+{
+  namespace Hardware
+  {
+    //! Buffers of batched reads, kept across calls.
+    struct CANSocket::Batch
+    {
+#if defined(DUNE_SYS_HAS_SOCKET_CAN) && defined(MSG_WAITFORONE)
+      std::vector<mmsghdr> msgs;
+      std::vector<iovec> iovs;
+      std::vector<can_frame> frames;
+      std::vector<Network::ReceiveTime::Control> controls;
+
+      //! Prepare the buffers to receive a number of frames.
+      //! @param[in] count number of frames.
+      void
+      prepare(size_t count)
+      {
+        msgs.resize(count);
+        iovs.resize(count);
+        frames.resize(count);
+        controls.resize(count);
+
+        // The kernel updates the control length of every message.
+        for (size_t i = 0; i < count; ++i)
+        {
+          Network::ReceiveTime::prepare(msgs[i].msg_hdr, iovs[i], &frames[i],
+                                        sizeof(can_frame), controls[i]);
+          msgs[i].msg_len = 0;
+        }
+      }
+#endif
+    };
+
+    CANSocket::CANSocket(const std::string& ifname):
+      m_handle((IO::NativeHandle)-1),
+      m_write_id(0),
+      m_write_ext(false),
+      m_read_time(IO::c_unknown_read_time),
+      m_batch(NULL)
+    {
+#if defined(DUNE_SYS_HAS_SOCKET_CAN)
+      if (ifname.size() >= IFNAMSIZ)
+        throw Error("opening " + ifname, "interface name too long");
+
+      m_handle = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+      if (m_handle < 0)
+        throw Error("creating socket", System::Error::getLastMessage());
+
+      ifreq ifr;
+      std::memset(&ifr, 0, sizeof(ifr));
+      std::strncpy(ifr.ifr_name, ifname.c_str(), IFNAMSIZ - 1);
+      if (ioctl(m_handle, SIOCGIFINDEX, &ifr) < 0)
+      {
+        std::string msg = System::Error::getLastMessage();
+        ::close(m_handle);
+        throw Error("finding " + ifname, msg);
+      }
+
+      sockaddr_can addr;
+      std::memset(&addr, 0, sizeof(addr));
+      addr.can_family = AF_CAN;
+      addr.can_ifindex = ifr.ifr_ifindex;
+      if (bind(m_handle, (sockaddr*)&addr, sizeof(addr)) < 0)
+      {
+        std::string msg = System::Error::getLastMessage();
+        ::close(m_handle);
+        throw Error("binding to " + ifname, msg);
+      }
+
+      // Kernel time stamps are optional, frames are stamped on
+      // reception by user space if they are not available.
+      Network::ReceiveTime::enable(m_handle, true);
+#else
+      (void)ifname;
+      throw NotImplemented("CAN");
+#endif
+    }
+
+    CANSocket::~CANSocket(void)
+    {
+#if defined(DUNE_SYS_HAS_SOCKET_CAN)
+      ::close(m_handle);
+#endif
+      delete m_batch;
+    }
+
+    void
+    CANSocket::setFilter(uint32_t id, uint32_t mask, bool extended)
+    {
+#if defined(DUNE_SYS_HAS_SOCKET_CAN)
+      can_filter filter;
+      if (extended)
+      {
+        filter.can_id = (id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+        filter.can_mask = (mask & CAN_EFF_MASK) | CAN_EFF_FLAG;
+      }
+      else
+      {
+        filter.can_id = id & CAN_SFF_MASK;
+        filter.can_mask = (mask & CAN_SFF_MASK) | CAN_EFF_FLAG;
+      }
+
+      if (setsockopt(m_handle, SOL_CAN_RAW, CAN_RAW_FILTER, &filter, sizeof(filter)) < 0)
+        throw Error("setting filter", System::Error::getLastMessage());
+#else
+      (void)id;
+      (void)mask;
+      (void)extended;
+#endif
+    }
+
+    void
+    CANSocket::writeFrame(const Frame& frame)
+    {
+#if defined(DUNE_SYS_HAS_SOCKET_CAN)
+      can_frame cf;
+      std::memset(&cf, 0, sizeof(cf));
+      if (frame.extended)
+        cf.can_id = (frame.id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+      else
+        cf.can_id = frame.id & CAN_SFF_MASK;
+
+      if (frame.rtr)
+        cf.can_id |= CAN_RTR_FLAG;
+
+      cf.can_dlc = frame.length > CAN_MAX_DLEN ? CAN_MAX_DLEN : frame.length;
+      std::memcpy(cf.data, frame.data, cf.can_dlc);
+
+      if (::write(m_handle, &cf, sizeof(cf)) != (ssize_t)sizeof(cf))
+        throw Error("writing frame", System::Error::getLastMessage());
+#else
+      (void)frame;
+#endif
+    }
+
+    void
+    CANSocket::readFrame(Frame& frame)
+    {
+#if defined(DUNE_SYS_HAS_SOCKET_CAN)
+      m_read_time = IO::c_unknown_read_time;
+
+      can_frame cf;
+      double time = IO::c_unknown_read_time;
+      if (Network::ReceiveTime::receive(m_handle, &cf, sizeof(cf), 0, NULL, NULL, time) != (ssize_t)sizeof(cf))
+        throw Error("reading frame", System::Error::getLastMessage());
+
+      fromNative(cf, time, frame);
+      m_read_time = frame.time;
+#else
+      (void)frame;
+#endif
+    }
+
+    unsigned
+    CANSocket::readFrames(std::vector<Frame>& frames)
+    {
+#if defined(DUNE_SYS_HAS_SOCKET_CAN)
+      m_read_time = IO::c_unknown_read_time;
+
+      if (frames.empty())
+        return 0;
+
+      unsigned count = 0;
+
+#  if defined(MSG_WAITFORONE)
+      if (m_batch == NULL)
+        m_batch = new Batch;
+
+      m_batch->prepare(frames.size());
+      std::vector<mmsghdr>& msgs = m_batch->msgs;
+
+      int rv = recvmmsg(m_handle, &msgs[0], frames.size(), MSG_DONTWAIT, NULL);
+      if (rv < 0)
+      {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+          return 0;
+
+        throw Error("reading frames", System::Error::getLastMessage());
+      }
+
+      for (int i = 0; i < rv; ++i)
+      {
+        if (msgs[i].msg_len != sizeof(can_frame))
+          continue;
+
+        fromNative(m_batch->frames[i], Network::ReceiveTime::get(&msgs[i].msg_hdr), frames[count++]);
+      }
+#  else
+      for (; count < frames.size(); ++count)
+      {
+        can_frame cf;
+        double time = IO::c_unknown_read_time;
+        if (Network::ReceiveTime::receive(m_handle, &cf, sizeof(cf), MSG_DONTWAIT, NULL, NULL, time) != (ssize_t)sizeof(cf))
+          break;
+
+        fromNative(cf, time, frames[count]);
+      }
+#  endif
+
+      if (count > 0)
+        m_read_time = frames[count - 1].time;
+
+      return count;
+#else
+      (void)frames;
+      return 0;
+#endif
+    }
+
+    size_t
+    CANSocket::doWrite(const uint8_t* bfr, size_t size)
+    {
+      Frame frame;
+      frame.id = m_write_id;
+      frame.extended = m_write_ext;
+
+      for (size_t i = 0; i < size; i += c_max_payload)
+      {
+        frame.length = (size - i) < c_max_payload ? (size - i) : c_max_payload;
+        std::memcpy(frame.data, bfr + i, frame.length);
+        writeFrame(frame);
+      }
+
+      return size;
+    }
+
+    size_t
+    CANSocket::doRead(uint8_t* bfr, size_t size)
+    {
+      Frame frame;
+      readFrame(frame);
+
+      size_t length = frame.length < size ? frame.length : size;
+      std::memcpy(bfr, frame.data, length);
+      return length;
+    }
+
+    void
+    CANSocket::doFlushInput(void)
+    {
+#if defined(DUNE_SYS_HAS_SOCKET_CAN)
+      can_frame cf;
+      while (recv(m_handle, &cf, sizeof(cf), MSG_DONTWAIT) > 0)
+        ;
+#endif
+    }
+  }
+}
@@ -0,0 +1,186 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef DUNE_HARDWARE_CAN_SOCKET_HPP_INCLUDED_
+#define DUNE_HARDWARE_CAN_SOCKET_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IO/Handle.hpp>
+
+namespace DUNE
+{
+  namespace Hardware
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM CANSocket;
+
+    //! The CANSocket class encapsulates access to a SocketCAN
+    //! network interface (e.g., can0 or the virtual vcan0). Frames
+    //! can be exchanged individually or, through the IO::Handle
+    //! interface, as a byte stream split in frames of a fixed
+    //! identifier.
+    class CANSocket: public IO::Handle
+    {
+    public:
+      class Error: public std::runtime_error
+      {
+      public:
+        Error(std::string op, std::string msg):
+          std::runtime_error("CAN socket error (" + op + "): " + msg)
+        { }
+      };
+
+      //! Maximum payload of a classic CAN frame.
+      static const unsigned c_max_payload = 8;
+
+      //! Classic CAN frame.
+      struct Frame
+      {
+        //! Frame identifier (11 or 29 bits).
+        uint32_t id;
+        //! True if the identifier is 29 bits long.
+        bool extended;
+        //! True for remote transmission requests.
+        bool rtr;
+        //! Payload length.
+        uint8_t length;
+        //! Payload.
+        uint8_t data[c_max_payload];
+        //! Kernel reception time (seconds since epoch).
+        double time;
+
+        Frame(void):
+          id(0),
+          extended(false),
+          rtr(false),
+          length(0),
+          time(-1.0)
+        { }
+      };
+
+      //! Open a raw CAN socket bound to a given network interface.
+      //! @param[in] ifname network interface name.
+      //! @throw CANSocket::Error.
+      CANSocket(const std::string& ifname);
+
+      //! Destructor.
+      ~CANSocket(void);
+
+      //! Only deliver frames whose identifier matches 'id' in the
+      //! bits set in 'mask'. By default all frames are delivered.
+      //! @param[in] id identifier.
+      //! @param[in] mask identifier mask.
+      //! @param[in] extended true to match 29 bit identifiers.
+      void
+      setFilter(uint32_t id, uint32_t mask, bool extended = false);
+
+      //! Set the identifier of frames sent through write().
+      //! @param[in] id identifier.
+      //! @param[in] extended true if the identifier is 29 bits long.
+      void
+      setWriteIdentifier(uint32_t id, bool extended = false)
+      {
+        m_write_id = id;
+        m_write_ext = extended;
+      }
+
+      //! Send one frame.
+      //! @param[in] frame frame to send.
+      void
+      writeFrame(const Frame& frame);
+
+      //! Receive one frame. Blocks until a frame is available, so
+      //! use IO::Poll beforehand when required.
+      //! @param[out] frame received frame.
+      void
+      readFrame(Frame& frame);
+
+      //! Receive all frames already queued in the socket, up to
+      //! the size of the given vector, in a single system call
+      //! where supported.
+      //! @param[out] frames frame buffer.
+      //! @return number of frames received.
+      unsigned
+      readFrames(std::vector<Frame>& frames);
+
+    private:
+      //! Socket handle.
+      IO::NativeHandle m_handle;
+      //! Identifier used by write().
+      uint32_t m_write_id;
+      //! True if the identifier used by write() is 29 bits long.
+      bool m_write_ext;
+      //! Arrival time of the last frame read.
+      double m_read_time;
+      //! Buffers of batched reads.
+      struct Batch;
+      Batch* m_batch;
+
+      IO::NativeHandle
+      doGetNative(void) const
+      {
+        return m_handle;
+      }
+
+      //! Split a buffer in frames with the configured identifier.
+      //! @param bfr buffer of bytes.
+      //! @param size amount of bytes to write.
+      //! @return amount of bytes actually written.
+      size_t
+      doWrite(const uint8_t* bfr, size_t size);
+
+      //! Read the payload of one frame.
+      //! @param bfr destination buffer.
+      //! @param size amount of bytes to read.
+      //! @return amount of bytes actually read.
+      size_t
+      doRead(uint8_t* bfr, size_t size);
+
+      //! Retrieve the kernel arrival time of the last frame read.
+      //! @return arrival time.
+      double
+      doGetLastReadTime(void) const
+      {
+        return m_read_time;
+      }
+
+      //! Discard all queued frames.
+      void
+      doFlushInput(void);
+    };
+  }
+}
+
+#endif
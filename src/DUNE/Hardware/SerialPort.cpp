@@ -40,6 +40,7 @@
 #include <DUNE/Time/Constants.hpp>
 #include <DUNE/Time/Utils.hpp>
 #include <DUNE/Time/Delay.hpp>
+#include <DUNE/Time/Clock.hpp>
 #include <DUNE/FileSystem/Path.hpp>
 #include <DUNE/System/Error.hpp>
 #include <DUNE/Hardware/SerialPort.hpp>
@@ -61,6 +62,10 @@
 #  include <sys/select.h>
 #endif
 
+#if defined(DUNE_SYS_HAS_SYS_IOCTL_H)
+#  include <sys/ioctl.h>
+#endif
+
 // Microsoft Windows headers.
 #if defined(DUNE_SYS_HAS_WINDOWS_H)
 #  include <windows.h>
@@ -188,7 +193,11 @@ namespace DUNE
       return devs;
     }
 
-    SerialPort::SerialPort(const std::string& device, int baudrate, Parity parity, StopBits stopbits, DataBits databits, bool block)
+    SerialPort::SerialPort(const std::string& device, int baudrate, Parity parity, StopBits stopbits, DataBits databits, bool block):
+      m_baudrate(baudrate),
+      m_read_time(IO::c_unknown_read_time),
+      m_ready_time(IO::c_unknown_read_time),
+      m_ready_bytes(0)
     {
 #if defined(DUNE_OS_POSIX)
       m_handle = open(device.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
@@ -318,6 +327,8 @@ namespace DUNE
     void
     SerialPort::setBaudRate(int baudrate)
     {
+      m_baudrate = baudrate;
+
 #if defined(DUNE_OS_POSIX)
       int v = baudrates[baudrate];
 
@@ -644,8 +655,14 @@ namespace DUNE
     size_t
     SerialPort::doRead(uint8_t* bfr, size_t size)
     {
+      m_read_time = IO::c_unknown_read_time;
+
 #if defined(DUNE_OS_POSIX)
-      return ::read(m_handle, bfr, size);
+      ssize_t rv = ::read(m_handle, bfr, size);
+      if (rv > 0)
+        m_read_time = estimateArrivalTime(rv);
+
+      return rv;
 
 #elif defined(DUNE_OS_WINDOWS)
       OVERLAPPED ov;
@@ -658,12 +675,105 @@ namespace DUNE
         if (GetLastError() != ERROR_IO_PENDING || !GetOverlappedResult(m_handle, &ov, &read_bytes, TRUE))
           read_bytes = -1;
       }
+      if (read_bytes != (DWORD)-1 && read_bytes > 0)
+        m_read_time = estimateArrivalTime(read_bytes);
+
       return read_bytes;
 #else
       return 0;
 #endif
     }
 
+    size_t
+    SerialPort::getPendingBytes(void)
+    {
+#if defined(DUNE_OS_POSIX) && defined(FIONREAD)
+      int pending = 0;
+      if (ioctl(m_handle, FIONREAD, &pending) == -1 || pending <= 0)
+        return 0;
+
+      return pending;
+
+#elif defined(DUNE_OS_WINDOWS)
+      COMSTAT stat;
+      DWORD errors = 0;
+      if (!ClearCommError(m_handle, &errors, &stat))
+        return 0;
+
+      return stat.cbInQue;
+
+#else
+      return 0;
+#endif
+    }
+
+    double
+    SerialPort::getByteTime(void) const
+    {
+      if (m_baudrate <= 0)
+        return 0.0;
+
+#if defined(DUNE_OS_POSIX)
+      // Start bit, data bits, parity bit and stop bits.
+      unsigned bits = 1;
+      switch (m_options.c_cflag & CSIZE)
+      {
+        case CS5:
+          bits += 5;
+          break;
+        case CS6:
+          bits += 6;
+          break;
+        case CS7:
+          bits += 7;
+          break;
+        default:
+          bits += 8;
+          break;
+      }
+
+      if (m_options.c_cflag & PARENB)
+        bits += 1;
+
+      bits += (m_options.c_cflag & CSTOPB) ? 2 : 1;
+
+#elif defined(DUNE_OS_WINDOWS)
+      unsigned bits = 1 + m_options.ByteSize + (m_options.Parity != NOPARITY ? 1 : 0)
+      + (m_options.StopBits == ONESTOPBIT ? 1 : 2);
+
+#else
+      unsigned bits = 10;
+#endif
+
+      return (double)bits / m_baudrate;
+    }
+
+    void
+    SerialPort::doSetReadyTime(double time)
+    {
+      m_ready_time = time;
+      m_ready_bytes = getPendingBytes();
+    }
+
+    double
+    SerialPort::estimateArrivalTime(size_t count)
+    {
+      double byte_time = getByteTime();
+
+      // Bytes buffered when the poll returned arrived before it, the
+      // last of them about when it returned.
+      if (m_ready_time != IO::c_unknown_read_time && count <= m_ready_bytes)
+      {
+        m_ready_bytes -= count;
+        return m_ready_time - m_ready_bytes * byte_time;
+      }
+
+      // Data arrived after the poll, bytes still buffered arrived
+      // after the last byte read.
+      m_ready_time = IO::c_unknown_read_time;
+      return Time::Clock::getSinceEpoch() - getPendingBytes() * byte_time;
+    }
+
     void
     SerialPort::doFlushInput(void)
     {
@@ -194,6 +194,14 @@ namespace DUNE
       DCB m_options;
 
 #endif
+      //! Current baud rate.
+      int m_baudrate;
+      //! Arrival time of the last byte read.
+      double m_read_time;
+      //! Time the last poll reported data ready to be read.
+      double m_ready_time;
+      //! Bytes buffered when the last poll returned and not yet read.
+      size_t m_ready_bytes;
 
       IO::NativeHandle
       doGetNative(void) const
@@ -215,6 +223,38 @@ namespace DUNE
       size_t
       doRead(uint8_t* bfr, size_t size);
 
+      //! Retrieve the arrival time of the last byte read.
+      //! @return arrival time.
+      double
+      doGetLastReadTime(void) const
+      {
+        return m_read_time;
+      }
+
+      //! Record the time a poll reported data ready to be read.
+      //! @param[in] time time in seconds since the Unix Epoch.
+      void
+      doSetReadyTime(double time);
+
+      //! Retrieve the number of bytes received but not read.
+      //! @return number of bytes.
+      size_t
+      getPendingBytes(void);
+
+      //! Retrieve the time a character takes on the line.
+      //! @return character time (s), or zero if not known.
+      double
+      getByteTime(void) const;
+
+      //! Estimate the arrival time of the last byte read. Data that
+      //! was buffered when the last poll returned is dated from the
+      //! poll, other data from the time of the read corrected for the
+      //! bytes still buffered.
+      //! @param[in] count number of bytes read.
+      //! @return arrival time.
+      double
+      estimateArrivalTime(size_t count);
+
       //! Flush input buffer, discarding all of it's contents.
       void
       doFlushInput(void);
@@ -38,12 +38,15 @@ namespace DUNE
 }
 
 #include <DUNE/IMC/Bus.hpp>
+#include <DUNE/IMC/SourcePredicate.hpp>
 #include <DUNE/IMC/Serialization.hpp>
 #include <DUNE/IMC/InlineMessage.hpp>
 #include <DUNE/IMC/MessageList.hpp>
 #include <DUNE/IMC/Message.hpp>
 #include <DUNE/IMC/Factory.hpp>
 #include <DUNE/IMC/Packet.hpp>
+#include <DUNE/IMC/DeltaCodec.hpp>
+#include <DUNE/IMC/DuplicateFilter.hpp>
 #include <DUNE/IMC/Macros.hpp>
 #include <DUNE/IMC/AddressResolver.hpp>
 #include <DUNE/IMC/Parser.hpp>
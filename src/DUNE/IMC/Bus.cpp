@@ -88,16 +88,47 @@ namespace DUNE
 
       Concurrency::ScopedRWLock l(m_lock, true);
       m_bind_msgs.push_back(bind);
-      TransportList::iterator itr = std::find(m_recipients[id].begin(), m_recipients[id].end(), task);
-      if (itr == m_recipients[id].end())
-        m_recipients[id].push_back(task);
+      TransportList& dlst(m_recipients[id]);
+      for (TransportList::iterator itr = dlst.begin(); itr != dlst.end(); ++itr)
+      {
+        if (itr->task == task)
+          return;
+      }
+
+      Subscription sub;
+      sub.task = task;
+      dlst.push_back(sub);
+    }
+
+    void
+    Bus::setRecipientSources(Tasks::AbstractTask* task, uint16_t id,
+                             const std::vector<SourcePredicate>& sources)
+    {
+      Concurrency::ScopedRWLock l(m_lock, true);
+      TransportList& dlst(m_recipients[id]);
+      for (TransportList::iterator itr = dlst.begin(); itr != dlst.end(); ++itr)
+      {
+        if (itr->task == task)
+        {
+          itr->sources = sources;
+          return;
+        }
+      }
     }
 
     void
     Bus::unregisterRecipient(Tasks::AbstractTask* task, uint16_t id)
     {
       Concurrency::ScopedRWLock l(m_lock, true);
-      m_recipients[id].remove(task);
+      TransportList& dlst(m_recipients[id]);
+      for (TransportList::iterator itr = dlst.begin(); itr != dlst.end(); ++itr)
+      {
+        if (itr->task == task)
+        {
+          dlst.erase(itr);
+          break;
+        }
+      }
     }
 
     void
@@ -117,8 +148,8 @@ namespace DUNE
       TransportList& dlst(m_recipients[id]);
       for (TransportList::iterator itr = dlst.begin(); itr != dlst.end(); ++itr)
       {
-        if (*itr != task)
-          (*itr)->receive(msg);
+        if (itr->task != task && itr->accepts(msg))
+          itr->task->receive(msg);
       }
     }
 
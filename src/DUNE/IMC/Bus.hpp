@@ -41,6 +41,7 @@
 
 // DUNE headers.
 #include <DUNE/Tasks/AbstractTask.hpp>
+#include <DUNE/IMC/SourcePredicate.hpp>
 #include <DUNE/Concurrency/TSQueue.hpp>
 #include <DUNE/Concurrency/ScopedMutex.hpp>
 #include <DUNE/Concurrency/ScopedRWLock.hpp>
@@ -72,6 +73,17 @@ namespace DUNE
       void
       registerRecipient(Tasks::AbstractTask* task, uint16_t id);
 
+      //! Restrict the sources of the messages with a given
+      //! identification number delivered to a registered task.
+      //! Messages are delivered if they satisfy any of the given
+      //! predicates.
+      //! @param task task object.
+      //! @param id message identification number.
+      //! @param sources source predicates (empty to accept any source).
+      void
+      setRecipientSources(Tasks::AbstractTask* task, uint16_t id,
+                          const std::vector<SourcePredicate>& sources);
+
       //! Unregister a task as a recipient of a given message
       //! identification number.
       //! @param task task object.
@@ -99,7 +111,34 @@ namespace DUNE
       getBindings(void);
 
     private:
-      typedef std::list<Tasks::AbstractTask*> TransportList;
+      //! Recipient of a message identifier.
+      struct Subscription
+      {
+        //! Task.
+        Tasks::AbstractTask* task;
+        //! Accepted sources (empty if any source is accepted).
+        std::vector<SourcePredicate> sources;
+
+        //! Test if a message is accepted by this subscription.
+        //! @param msg message.
+        //! @return true if the message is accepted, false otherwise.
+        bool
+        accepts(const Message* msg) const
+        {
+          if (sources.empty())
+            return true;
+
+          for (size_t i = 0; i < sources.size(); ++i)
+          {
+            if (sources[i].match(msg))
+              return true;
+          }
+
+          return false;
+        }
+      };
+
+      typedef std::list<Subscription> TransportList;
       //! Table of recipients.
       std::map<uint16_t, TransportList> m_recipients;
       //! Internal list lock.
@@ -0,0 +1,245 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/Utils/ByteCopy.hpp>
+#include <DUNE/IMC/Constants.hpp>
+#include <DUNE/IMC/DeltaCodec.hpp>
+#include <DUNE/IMC/Message.hpp>
+#include <DUNE/IMC/Packet.hpp>
+#include <DUNE/IMC/Serialization.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Offset of the message identifier in a packet.
+    static const unsigned c_id_offset = 2;
+    //! Offset of the source in a packet.
+    static const unsigned c_src_offset = 14;
+    //! Offset of the source entity in a packet.
+    static const unsigned c_src_ent_offset = 16;
+    //! Maximum number of bytes in a run.
+    static const unsigned c_max_run = 128;
+
+    //! Compute the key of a stream.
+    static inline uint64_t
+    getStreamKey(uint16_t id, uint16_t src, uint8_t src_ent)
+    {
+      return ((uint64_t)id << 24) | ((uint64_t)src << 8) | src_ent;
+    }
+
+    DeltaEncoder::DeltaEncoder(unsigned keyframe_interval):
+      m_keyframe_interval(keyframe_interval)
+    { }
+
+    void
+    DeltaEncoder::reset(void)
+    {
+      m_refs.clear();
+    }
+
+    void
+    DeltaEncoder::writeMarker(Utils::ByteBuffer& bfr)
+    {
+      bfr.setSize(c_delta_header_size);
+      uint8_t* ptr = bfr.getBuffer();
+      ptr += IMC::serialize(c_delta_sync, ptr);
+      ptr += IMC::serialize(c_delta_marker_id, ptr);
+      ptr += IMC::serialize((uint16_t)0, ptr);
+      ptr += IMC::serialize((uint8_t)0, ptr);
+      IMC::serialize((uint16_t)0, ptr);
+    }
+
+    bool
+    DeltaEncoder::encode(const Message* msg, Utils::ByteBuffer& bfr)
+    {
+      uint16_t size = Packet::serialize(msg, m_packet);
+      const uint8_t* pkt = m_packet.getBuffer();
+
+      uint16_t id = msg->getId();
+      uint16_t src = msg->getSource();
+      uint8_t src_ent = msg->getSourceEntity();
+      Reference& ref = m_refs[getStreamKey(id, src, src_ent)];
+
+      if (ref.packet.size() == size && ref.deltas < m_keyframe_interval)
+      {
+        bfr.setSize(c_delta_header_size + 2 * size);
+        uint8_t* start = bfr.getBuffer() + c_delta_header_size;
+        uint8_t* out = start;
+        const uint8_t* prv = &ref.packet[0];
+        unsigned i = 0;
+
+        while (i < size)
+        {
+          unsigned run = 0;
+          if (pkt[i] == prv[i])
+          {
+            while (i < size && run < c_max_run && pkt[i] == prv[i])
+            {
+              ++run;
+              ++i;
+            }
+
+            *out++ = 0x80 | (run - 1);
+            continue;
+          }
+
+          // Isolated zeros are cheaper as literals.
+          uint8_t* ctl = out++;
+          while (i < size && run < c_max_run
+                 && (pkt[i] != prv[i] || (i + 1 < size && pkt[i + 1] != prv[i + 1])))
+          {
+            *out++ = pkt[i] ^ prv[i];
+            ++run;
+            ++i;
+          }
+
+          *ctl = run - 1;
+        }
+
+        uint16_t length = out - start;
+        if (length + c_delta_header_size < size)
+        {
+          uint8_t* ptr = bfr.getBuffer();
+          ptr += IMC::serialize(c_delta_sync, ptr);
+          ptr += IMC::serialize(id, ptr);
+          ptr += IMC::serialize(src, ptr);
+          ptr += IMC::serialize(src_ent, ptr);
+          IMC::serialize(length, ptr);
+          bfr.setSize(c_delta_header_size + length);
+
+          std::memcpy(&ref.packet[0], pkt, size);
+          ++ref.deltas;
+          return true;
+        }
+      }
+
+      bfr.write(pkt, size);
+      ref.packet.assign(pkt, pkt + size);
+      ref.deltas = 0;
+      return false;
+    }
+
+    uint16_t
+    DeltaDecoder::getLength(const uint8_t* header)
+    {
+      uint16_t sync = 0;
+      uint16_t length = 0;
+      Utils::ByteCopy::copy(sync, header);
+
+      if (sync == c_delta_sync_rev)
+        Utils::ByteCopy::rcopy(length, header + 7);
+      else
+        Utils::ByteCopy::copy(length, header + 7);
+
+      return length;
+    }
+
+    void
+    DeltaDecoder::update(const uint8_t* packet, uint16_t size)
+    {
+      if (size < DUNE_IMC_CONST_HEADER_SIZE)
+        return;
+
+      uint16_t sync = 0;
+      uint16_t id = 0;
+      uint16_t src = 0;
+      std::memcpy(&sync, packet, sizeof(sync));
+      std::memcpy(&id, packet + c_id_offset, sizeof(id));
+      std::memcpy(&src, packet + c_src_offset, sizeof(src));
+
+      // Streams are keyed by the bytes as written, so the byte order
+      // of the writer does not matter.
+      if (sync != DUNE_IMC_CONST_SYNC && sync != DUNE_IMC_CONST_SYNC_REV)
+        return;
+
+      m_refs[getStreamKey(id, src, packet[c_src_ent_offset])].assign(packet, packet + size);
+    }
+
+    bool
+    DeltaDecoder::decode(const uint8_t* frame, uint32_t size, Utils::ByteBuffer& bfr)
+    {
+      if (size < c_delta_header_size)
+        return false;
+
+      uint16_t id = 0;
+      uint16_t src = 0;
+      uint16_t length = getLength(frame);
+      std::memcpy(&id, frame + 2, sizeof(id));
+      std::memcpy(&src, frame + 4, sizeof(src));
+
+      if (size < (uint32_t)c_delta_header_size + length)
+        return false;
+
+      std::map<uint64_t, std::vector<uint8_t> >::iterator itr = m_refs.find(getStreamKey(id, src, frame[6]));
+      if (itr == m_refs.end())
+        return false;
+
+      const std::vector<uint8_t>& prv = itr->second;
+      bfr.setSize(prv.size());
+      uint8_t* out = bfr.getBuffer();
+      const uint8_t* in = frame + c_delta_header_size;
+      const uint8_t* end = in + length;
+      size_t pos = 0;
+
+      while (in < end)
+      {
+        uint8_t ctl = *in++;
+        size_t run = (ctl & 0x7f) + 1;
+        if (pos + run > prv.size())
+          return false;
+
+        if (ctl & 0x80)
+        {
+          std::memcpy(out + pos, &prv[pos], run);
+        }
+        else
+        {
+          if (in + run > end)
+            return false;
+
+          for (size_t i = 0; i < run; ++i)
+            out[pos + i] = prv[pos + i] ^ *in++;
+        }
+
+        pos += run;
+      }
+
+      if (pos != prv.size())
+        return false;
+
+      itr->second.assign(out, out + pos);
+      return true;
+    }
+  }
+}
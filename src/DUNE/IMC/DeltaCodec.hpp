@@ -0,0 +1,167 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef DUNE_IMC_DELTA_CODEC_HPP_INCLUDED_
+#define DUNE_IMC_DELTA_CODEC_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <map>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Utils/ByteBuffer.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Forward declarations.
+    class Message;
+
+    //! Synchronization number of delta frames.
+    static const uint16_t c_delta_sync = 0xFE55;
+    //! Synchronization number of delta frames written in the other
+    //! byte order.
+    static const uint16_t c_delta_sync_rev = 0x55FE;
+    //! Size of the header of delta frames.
+    static const uint16_t c_delta_header_size = 9;
+    //! Message identifier of the delta frame that enables decoding.
+    static const uint16_t c_delta_marker_id = 0xFFFF;
+
+    //! Delta frames store a packet as the XOR of its serialized form
+    //! and the serialized form of the previous packet with the same
+    //! message identifier, source and source entity. Since fixed
+    //! size messages keep each field at the same offset, unchanged
+    //! fields and the high order bytes of slowly varying fields
+    //! become zeros, which are run-length encoded. Like regular
+    //! packets, delta frames are written in the byte order of the
+    //! writer and readers recognize the other byte order by the
+    //! swapped synchronization number. Delta frame layout:
+    //!
+    //! - synchronization number (c_delta_sync, 2 bytes);
+    //! - message identifier (2 bytes);
+    //! - source (2 bytes);
+    //! - source entity (1 byte);
+    //! - length of the encoded data (2 bytes);
+    //! - encoded data.
+    //!
+    //! The encoded data is a sequence of runs, each starting with a
+    //! control byte: if the most significant bit is set the run is
+    //! (control & 0x7f) + 1 zeros, otherwise it is control + 1
+    //! literal bytes that follow.
+    //!
+    //! Regular packets are keyframes: they are stored unmodified and
+    //! reset the reference of their stream.
+
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM DeltaEncoder;
+
+    class DeltaEncoder
+    {
+    public:
+      //! Constructor.
+      //! @param[in] keyframe_interval maximum number of delta frames
+      //! between two keyframes of the same stream.
+      DeltaEncoder(unsigned keyframe_interval);
+
+      //! Forget all references, so that the next message of every
+      //! stream is stored as a keyframe. Must be called whenever
+      //! packets not produced by this encoder are written to the
+      //! same output.
+      void
+      reset(void);
+
+      //! Write the frame that enables delta decoding. Must be the
+      //! first frame of every output.
+      //! @param[out] bfr destination buffer.
+      void
+      writeMarker(Utils::ByteBuffer& bfr);
+
+      //! Encode a message as a keyframe or a delta frame.
+      //! @param[in] msg message.
+      //! @param[out] bfr destination buffer.
+      //! @return true if a delta frame was produced, false if a
+      //! keyframe was produced.
+      bool
+      encode(const Message* msg, Utils::ByteBuffer& bfr);
+
+    private:
+      //! Reference of a stream.
+      struct Reference
+      {
+        //! Last packet.
+        std::vector<uint8_t> packet;
+        //! Number of delta frames since the last keyframe.
+        unsigned deltas;
+      };
+
+      //! Maximum number of delta frames between keyframes.
+      unsigned m_keyframe_interval;
+      //! References by stream.
+      std::map<uint64_t, Reference> m_refs;
+      //! Serialization buffer.
+      Utils::ByteBuffer m_packet;
+    };
+
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM DeltaDecoder;
+
+    class DeltaDecoder
+    {
+    public:
+      //! Get the length of the encoded data of a delta frame.
+      //! @param[in] header delta frame header.
+      //! @return length of the encoded data.
+      static uint16_t
+      getLength(const uint8_t* header);
+
+      //! Record a regular packet as the reference of its stream.
+      //! @param[in] packet serialized packet.
+      //! @param[in] size packet size.
+      void
+      update(const uint8_t* packet, uint16_t size);
+
+      //! Decode a delta frame.
+      //! @param[in] frame delta frame, including header.
+      //! @param[in] size frame size.
+      //! @param[out] bfr decoded packet.
+      //! @return true if the frame was decoded, false if the
+      //! reference of the stream is unknown or does not match.
+      bool
+      decode(const uint8_t* frame, uint32_t size, Utils::ByteBuffer& bfr);
+
+    private:
+      //! References by stream.
+      std::map<uint64_t, std::vector<uint8_t> > m_refs;
+    };
+  }
+}
+
+#endif
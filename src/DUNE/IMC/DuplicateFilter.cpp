@@ -0,0 +1,256 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// DUNE headers.
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+#include <DUNE/IMC/DuplicateFilter.hpp>
+#include <DUNE/IMC/Message.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! FNV-1a offset basis.
+    static const uint32_t c_fnv_basis = 2166136261u;
+    //! FNV-1a prime.
+    static const uint32_t c_fnv_prime = 16777619u;
+    //! Link identifier used for messages carrying their timestamp.
+    static const unsigned c_timed_link = ~0u;
+
+    //! Compute the FNV-1a hash of a buffer.
+    //! @param[in] data buffer.
+    //! @param[in] size buffer size.
+    //! @return hash value.
+    static uint32_t
+    hash(const uint8_t* data, size_t size)
+    {
+      uint32_t value = c_fnv_basis;
+
+      for (size_t i = 0; i < size; ++i)
+        value = (value ^ data[i]) * c_fnv_prime;
+
+      return value;
+    }
+
+    bool
+    DuplicateFilter::Key::operator<(const Key& other) const
+    {
+      if (timestamp != other.timestamp)
+        return timestamp < other.timestamp;
+
+      if (src != other.src)
+        return src < other.src;
+
+      if (id != other.id)
+        return id < other.id;
+
+      if (src_ent != other.src_ent)
+        return src_ent < other.src_ent;
+
+      return hash < other.hash;
+    }
+
+    bool
+    DuplicateFilter::LinkKey::operator<(const LinkKey& other) const
+    {
+      if (hash != other.hash)
+        return hash < other.hash;
+
+      if (src != other.src)
+        return src < other.src;
+
+      return id < other.id;
+    }
+
+    DuplicateFilter::DuplicateFilter(double window, size_t capacity):
+      m_window(window),
+      m_capacity(capacity),
+      m_dups(0)
+    { }
+
+    bool
+    DuplicateFilter::accept(const Message* msg, double now)
+    {
+      Concurrency::ScopedMutex l(m_lock);
+
+      m_bfr.resize(msg->getPayloadSerializationSize());
+      if (!m_bfr.empty())
+        msg->serializeFields(&m_bfr[0]);
+
+      return acceptTimed(msg, m_bfr.empty() ? NULL : &m_bfr[0], m_bfr.size(), now);
+    }
+
+    bool
+    DuplicateFilter::accept(const Message* msg, const uint8_t* payload, size_t size, double now)
+    {
+      Concurrency::ScopedMutex l(m_lock);
+      return acceptTimed(msg, payload, size, now);
+    }
+
+    bool
+    DuplicateFilter::acceptUntimed(const Message* msg, const uint8_t* payload, size_t size,
+                                   unsigned link, double now)
+    {
+      Concurrency::ScopedMutex l(m_lock);
+
+      expire(now);
+
+      LinkKey key;
+      key.src = msg->getSource();
+      key.id = msg->getId();
+      key.hash = hash(payload, size);
+
+      if (seenOnOtherLink(key, link, now))
+      {
+        ++m_dups;
+        return false;
+      }
+
+      return true;
+    }
+
+    void
+    DuplicateFilter::clear(void)
+    {
+      Concurrency::ScopedMutex l(m_lock);
+      m_order.clear();
+      m_seen.clear();
+      m_link_order.clear();
+      m_links.clear();
+    }
+
+    size_t
+    DuplicateFilter::size(void) const
+    {
+      Concurrency::ScopedMutex l(m_lock);
+      return m_seen.size();
+    }
+
+    unsigned long
+    DuplicateFilter::getDuplicateCount(void) const
+    {
+      Concurrency::ScopedMutex l(m_lock);
+      return m_dups;
+    }
+
+    bool
+    DuplicateFilter::acceptTimed(const Message* msg, const uint8_t* payload, size_t size, double now)
+    {
+      expire(now);
+
+      Key key;
+      key.src = msg->getSource();
+      key.src_ent = msg->getSourceEntity();
+      key.id = msg->getId();
+      key.timestamp = msg->getTimeStamp();
+      key.hash = hash(payload, size);
+
+      std::pair<Map::iterator, bool> rv = m_seen.insert(std::make_pair(key, now));
+      if (!rv.second)
+      {
+        ++m_dups;
+        return false;
+      }
+
+      m_order.push_back(rv.first);
+
+      if (m_order.size() > m_capacity)
+      {
+        m_seen.erase(m_order.front());
+        m_order.pop_front();
+      }
+
+      // Copies received over links without timestamps.
+      LinkKey lkey;
+      lkey.src = key.src;
+      lkey.id = key.id;
+      lkey.hash = key.hash;
+
+      if (seenOnOtherLink(lkey, c_timed_link, now))
+      {
+        ++m_dups;
+        return false;
+      }
+
+      return true;
+    }
+
+    bool
+    DuplicateFilter::seenOnOtherLink(const LinkKey& key, unsigned link, double now)
+    {
+      LinkEntry entry;
+      entry.time = now;
+      entry.link = link;
+
+      std::pair<LinkMap::iterator, bool> rv = m_links.insert(std::make_pair(key, entry));
+      bool other = !rv.second && rv.first->second.link != link;
+
+      // The last copy claims the content, so that a later copy over
+      // the same link is taken as a new message.
+      if (!rv.second)
+        rv.first->second = entry;
+
+      m_link_order.push_back(std::make_pair(now, key));
+
+      while (m_link_order.size() > m_capacity)
+      {
+        forget(m_link_order.front());
+        m_link_order.pop_front();
+      }
+
+      return other;
+    }
+
+    void
+    DuplicateFilter::forget(const std::pair<double, LinkKey>& item)
+    {
+      LinkMap::iterator itr = m_links.find(item.second);
+
+      // Skip contents refreshed by a later copy.
+      if (itr != m_links.end() && itr->second.time == item.first)
+        m_links.erase(itr);
+    }
+
+    void
+    DuplicateFilter::expire(double now)
+    {
+      while (!m_order.empty() && now - m_order.front()->second >= m_window)
+      {
+        m_seen.erase(m_order.front());
+        m_order.pop_front();
+      }
+
+      while (!m_link_order.empty() && now - m_link_order.front().first >= m_window)
+      {
+        forget(m_link_order.front());
+        m_link_order.pop_front();
+      }
+    }
+  }
+}
@@ -0,0 +1,224 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef DUNE_IMC_DUPLICATE_FILTER_HPP_INCLUDED_
+#define DUNE_IMC_DUPLICATE_FILTER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM DuplicateFilter;
+
+    // Forward declarations.
+    class Message;
+
+    //! Time-windowed cache of recently received messages, used at
+    //! transport ingress to drop copies of a message arriving over
+    //! more than one link. Messages are identified by source, source
+    //! entity, identifier, timestamp and a hash of their payload as
+    //! received. Links that do not preserve the timestamp or source
+    //! entity (e.g. radio modems, Iridium) match copies on source,
+    //! identifier and payload hash only, and a copy is dropped when
+    //! the same content was received over a different link within
+    //! the time window. This class is thread-safe.
+    class DuplicateFilter
+    {
+    public:
+      //! Constructor.
+      //! @param[in] window time during which a message is remembered (s).
+      //! @param[in] capacity maximum number of remembered messages.
+      DuplicateFilter(double window = 60.0, size_t capacity = 8192);
+
+      //! Check if a message was already received within the time
+      //! window and remember it otherwise. The payload is serialized
+      //! to be hashed, prefer the overload taking the received bytes
+      //! when they are available.
+      //! @param[in] msg message.
+      //! @param[in] now current monotonic time (s).
+      //! @return true if this is the first copy of the message,
+      //! false if it is a duplicate.
+      bool
+      accept(const Message* msg, double now);
+
+      //! Check if a message was already received within the time
+      //! window and remember it otherwise.
+      //! @param[in] msg message.
+      //! @param[in] payload serialized payload as received.
+      //! @param[in] size size of the serialized payload.
+      //! @param[in] now current monotonic time (s).
+      //! @return true if this is the first copy of the message,
+      //! false if it is a duplicate.
+      bool
+      accept(const Message* msg, const uint8_t* payload, size_t size, double now);
+
+      //! Check if a message received over a link that does not
+      //! preserve timestamps was already received over another link
+      //! within the time window and remember it otherwise. Repeated
+      //! copies over the same link are accepted, since they cannot
+      //! be told apart from new messages with the same content.
+      //! @param[in] msg message.
+      //! @param[in] payload serialized payload as received.
+      //! @param[in] size size of the serialized payload.
+      //! @param[in] link identifier of the receiving link (e.g. the
+      //! entity of the receiving task).
+      //! @param[in] now current monotonic time (s).
+      //! @return true if this is the first copy of the message,
+      //! false if it is a duplicate.
+      bool
+      acceptUntimed(const Message* msg, const uint8_t* payload, size_t size,
+                    unsigned link, double now);
+
+      //! Forget all remembered messages.
+      void
+      clear(void);
+
+      //! Retrieve the number of remembered messages.
+      //! @return number of messages.
+      size_t
+      size(void) const;
+
+      //! Retrieve the number of duplicates dropped so far.
+      //! @return number of duplicates.
+      unsigned long
+      getDuplicateCount(void) const;
+
+    private:
+      //! Message identity.
+      struct Key
+      {
+        //! Source system.
+        uint16_t src;
+        //! Source entity.
+        uint8_t src_ent;
+        //! Message identifier.
+        uint16_t id;
+        //! Message timestamp.
+        double timestamp;
+        //! Payload hash.
+        uint32_t hash;
+
+        bool
+        operator<(const Key& other) const;
+      };
+
+      //! Message identity preserved by all links.
+      struct LinkKey
+      {
+        //! Source system.
+        uint16_t src;
+        //! Message identifier.
+        uint16_t id;
+        //! Payload hash.
+        uint32_t hash;
+
+        bool
+        operator<(const LinkKey& other) const;
+      };
+
+      //! Last copy of a message content.
+      struct LinkEntry
+      {
+        //! Arrival time.
+        double time;
+        //! Receiving link.
+        unsigned link;
+      };
+
+      //! Remembered messages and their arrival time.
+      typedef std::map<Key, double> Map;
+      //! Remembered message contents and their last copy.
+      typedef std::map<LinkKey, LinkEntry> LinkMap;
+
+      //! Time during which a message is remembered.
+      double m_window;
+      //! Maximum number of remembered messages.
+      size_t m_capacity;
+      //! Remembered messages.
+      Map m_seen;
+      //! Remembered messages in arrival order.
+      std::deque<Map::iterator> m_order;
+      //! Remembered message contents.
+      LinkMap m_links;
+      //! Remembered message contents in arrival order.
+      std::deque<std::pair<double, LinkKey> > m_link_order;
+      //! Serialization buffer.
+      std::vector<uint8_t> m_bfr;
+      //! Number of duplicates dropped.
+      unsigned long m_dups;
+      //! Concurrency lock.
+      mutable Concurrency::Mutex m_lock;
+
+      //! Check if a message carrying its timestamp was already
+      //! received and remember it otherwise. The lock must be held.
+      //! @param[in] msg message.
+      //! @param[in] payload serialized payload.
+      //! @param[in] size size of the serialized payload.
+      //! @param[in] now current monotonic time (s).
+      //! @return true if this is the first copy of the message,
+      //! false if it is a duplicate.
+      bool
+      acceptTimed(const Message* msg, const uint8_t* payload, size_t size, double now);
+
+      //! Forget a message content unless it was refreshed later.
+      //! @param[in] item arrival time and message content.
+      void
+      forget(const std::pair<double, LinkKey>& item);
+
+      //! Forget messages older than the time window and enforce
+      //! the capacity.
+      //! @param[in] now current monotonic time (s).
+      void
+      expire(double now);
+
+      //! Remember the content of a message and check if it was last
+      //! received over another link.
+      //! @param[in] key message content.
+      //! @param[in] link receiving link.
+      //! @param[in] now current monotonic time (s).
+      //! @return true if the content was last received over another
+      //! link, false otherwise.
+      bool
+      seenOnOtherLink(const LinkKey& key, unsigned link, double now);
+    };
+  }
+}
+
+#endif
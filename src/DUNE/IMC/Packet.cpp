@@ -29,6 +29,9 @@
 
 // ISO C++ 98 headers.
 #include <cstddef>
+#include <cstring>
+#include <ios>
+#include <istream>
 
 // DUNE headers.
 #include <DUNE/Utils/ByteCopy.hpp>
@@ -38,6 +41,7 @@
 #include <DUNE/IMC/Factory.hpp>
 #include <DUNE/IMC/Packet.hpp>
 #include <DUNE/IMC/Constants.hpp>
+#include <DUNE/IMC/DeltaCodec.hpp>
 
 namespace DUNE
 {
@@ -105,62 +109,132 @@ namespace DUNE
       return deserializePayload(hdr, bfr, bfr_len, msg);
     }
 
-    Message*
-    Packet::deserialize(std::istream& ifs)
+    //! Index of the delta decoder in the extensible array of streams.
+    static int
+    getDecoderIndex(void)
     {
-      std::vector<char> data;
-
-      // Get the message header.
-      data.resize(DUNE_IMC_CONST_HEADER_SIZE);
-      ifs.read(&data[0], DUNE_IMC_CONST_HEADER_SIZE);
-
-      // If we're at the EOF there's nothing more to do.
-      if (ifs.eof())
-        return 0;
+      static const int index = std::ios_base::xalloc();
+      return index;
+    }
 
-      if (ifs.gcount() < DUNE_IMC_CONST_HEADER_SIZE)
-        throw BufferTooShort();
+    //! Release the delta decoder of a stream.
+    static void
+    onStreamEvent(std::ios_base::event ev, std::ios_base& ios, int index)
+    {
+      void*& ptr = ios.pword(index);
+      if (ev == std::ios_base::erase_event)
+        delete static_cast<DeltaDecoder*>(ptr);
 
-      Header hdr;
-      deserializeHeader(hdr, (uint8_t*)&data[0], DUNE_IMC_CONST_HEADER_SIZE);
+      // Copies of a stream do not share its decoder.
+      if (ev == std::ios_base::erase_event || ev == std::ios_base::copyfmt_event)
+        ptr = NULL;
+    }
 
-      // Get remaining data.
-      uint16_t remaining = hdr.size + DUNE_IMC_CONST_FOOTER_SIZE;
-      data.resize(DUNE_IMC_CONST_HEADER_SIZE + remaining);
-      ifs.read(&data[DUNE_IMC_CONST_HEADER_SIZE], remaining);
+    //! Get the delta decoder of a stream.
+    //! @param[in] ifs input stream.
+    //! @param[in] create create the decoder if the stream has none.
+    //! @return delta decoder or NULL.
+    static DeltaDecoder*
+    getDecoder(std::istream& ifs, bool create)
+    {
+      int index = getDecoderIndex();
+      void*& ptr = ifs.pword(index);
+      if (ptr == NULL && create)
+      {
+        ptr = new DeltaDecoder;
+        ifs.register_callback(onStreamEvent, index);
+      }
 
-      if (ifs.gcount() < remaining)
-        throw BufferTooShort();
+      return static_cast<DeltaDecoder*>(ptr);
+    }
 
-      return deserializePayload(hdr, (uint8_t*)&data[0], DUNE_IMC_CONST_HEADER_SIZE + remaining, 0);
+    Message*
+    Packet::deserialize(std::istream& ifs)
+    {
+      Utils::ByteBuffer bfr(DUNE_IMC_CONST_HEADER_SIZE);
+      return deserialize(ifs, bfr);
     }
 
     Message*
     Packet::deserialize(std::istream& ifs, Utils::ByteBuffer& bfr)
     {
-      // Get the message header.
-      bfr.setSize(DUNE_IMC_CONST_HEADER_SIZE);
-      ifs.read(bfr.getBufferSigned(), DUNE_IMC_CONST_HEADER_SIZE);
-
-      // If we're at the EOF there's nothing more to do.
-      if (ifs.eof())
-        return 0;
-
-      if (ifs.gcount() < DUNE_IMC_CONST_HEADER_SIZE)
-        throw BufferTooShort();
-
-      Header hdr;
-      deserializeHeader(hdr, bfr.getBuffer(), DUNE_IMC_CONST_HEADER_SIZE);
-
-      // Get remaining data.
-      uint16_t remaining = hdr.size + DUNE_IMC_CONST_FOOTER_SIZE;
-      bfr.setSize(DUNE_IMC_CONST_HEADER_SIZE + remaining);
-      ifs.read(bfr.getBufferSigned() + DUNE_IMC_CONST_HEADER_SIZE, remaining);
-
-      if (ifs.gcount() < remaining)
-        throw BufferTooShort();
-
-      return deserializePayload(hdr, bfr.getBuffer(), DUNE_IMC_CONST_HEADER_SIZE + remaining, 0);
+      while (true)
+      {
+        // Get the synchronization number.
+        uint16_t sync = 0;
+        ifs.read((char*)&sync, sizeof(sync));
+
+        // If we're at the EOF there's nothing more to do.
+        if (ifs.eof())
+          return 0;
+
+        if (ifs.gcount() < (std::streamsize)sizeof(sync))
+          throw BufferTooShort();
+
+        if (sync == c_delta_sync || sync == c_delta_sync_rev)
+        {
+          // Decode delta frames back into regular packets.
+          Utils::ByteBuffer frame(c_delta_header_size);
+          frame.setSize(c_delta_header_size);
+          std::memcpy(frame.getBuffer(), &sync, sizeof(sync));
+          ifs.read(frame.getBufferSigned() + sizeof(sync), c_delta_header_size - sizeof(sync));
+          if (ifs.eof())
+            return 0;
+
+          if (ifs.gcount() < c_delta_header_size - (std::streamsize)sizeof(sync))
+            throw BufferTooShort();
+
+          // The marker identifier reads the same in both byte orders.
+          uint16_t id = 0;
+          uint16_t length = DeltaDecoder::getLength(frame.getBuffer());
+          std::memcpy(&id, frame.getBuffer() + 2, sizeof(id));
+          frame.setSize(c_delta_header_size + length);
+          ifs.read(frame.getBufferSigned() + c_delta_header_size, length);
+          if (ifs.gcount() < length)
+            throw BufferTooShort();
+
+          DeltaDecoder* decoder = getDecoder(ifs, id == c_delta_marker_id);
+          if (id == c_delta_marker_id)
+            continue;
+
+          // Frames whose reference was not seen are skipped.
+          if (decoder == NULL || !decoder->decode(frame.getBuffer(), frame.getSize(), bfr))
+            continue;
+        }
+        else
+        {
+          // Get the message header.
+          bfr.setSize(DUNE_IMC_CONST_HEADER_SIZE);
+          std::memcpy(bfr.getBuffer(), &sync, sizeof(sync));
+          ifs.read(bfr.getBufferSigned() + sizeof(sync), DUNE_IMC_CONST_HEADER_SIZE - sizeof(sync));
+
+          // A truncated header at the end of the stream is ignored.
+          if (ifs.eof())
+            return 0;
+
+          if (ifs.gcount() < DUNE_IMC_CONST_HEADER_SIZE - (std::streamsize)sizeof(sync))
+            throw BufferTooShort();
+
+          Header hdr;
+          deserializeHeader(hdr, bfr.getBuffer(), DUNE_IMC_CONST_HEADER_SIZE);
+
+          // Get remaining data.
+          uint16_t remaining = hdr.size + DUNE_IMC_CONST_FOOTER_SIZE;
+          bfr.setSize(DUNE_IMC_CONST_HEADER_SIZE + remaining);
+          ifs.read(bfr.getBufferSigned() + DUNE_IMC_CONST_HEADER_SIZE, remaining);
+
+          if (ifs.gcount() < remaining)
+            throw BufferTooShort();
+
+          DeltaDecoder* decoder = getDecoder(ifs, false);
+          if (decoder != NULL)
+            decoder->update(bfr.getBuffer(), bfr.getSize());
+        }
+
+        Header hdr;
+        deserializeHeader(hdr, bfr.getBuffer(), bfr.getSize());
+        return deserializePayload(hdr, bfr.getBuffer(), bfr.getSize(), 0);
+      }
     }
 
     uint16_t
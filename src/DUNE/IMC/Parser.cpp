@@ -48,6 +48,7 @@ namespace DUNE
     {
       m_stage = c_sync;
       m_pos = 0;
+      m_payload = 0;
       m_buf.clear();
     }
 
@@ -55,6 +56,11 @@ namespace DUNE
     Parser::parse(uint8_t byte)
     {
       Message* m = 0;
+
+      // Data of the last message is kept until now for getPayload().
+      if (m_pos != 0 && m_pos == m_buf.size())
+        reset();
+
       m_buf.push_back(byte);
 
       while (true)
@@ -122,11 +128,8 @@ namespace DUNE
           continue;
         }
 
+        m_payload = m_pos + DUNE_IMC_CONST_HEADER_SIZE;
         m_pos += n;
-
-        if (m_pos == m_buf.size())
-          reset();  // discard unneeded data
-
         break;
       }
 
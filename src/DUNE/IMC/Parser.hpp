@@ -63,6 +63,24 @@ namespace DUNE
       Message*
       parse(uint8_t byte);
 
+      //! Get the serialized payload of the last parsed message. It
+      //! remains valid until the next call to parse() or reset().
+      //! @return payload data.
+      const uint8_t*
+      getPayload(void) const
+      {
+        return &m_buf[m_payload];
+      }
+
+      //! Get the size of the serialized payload of the last parsed
+      //! message.
+      //! @return payload size.
+      unsigned int
+      getPayloadSize(void) const
+      {
+        return m_header.size;
+      }
+
     private:
       //! Parser stage constants.
       enum ParserStage
@@ -75,6 +93,7 @@ namespace DUNE
       ParserStage m_stage; //!< Parser stage.
       std::vector<uint8_t> m_buf; //!< Internal buffer.
       unsigned int m_pos; //!< Buffer position.
+      unsigned int m_payload; //!< Payload position of the last message.
       Header m_header; //!< Holds parsed header (c_payload stage).
     };
   }
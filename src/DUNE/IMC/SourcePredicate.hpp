@@ -0,0 +1,146 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef DUNE_IMC_SOURCE_PREDICATE_HPP_INCLUDED_
+#define DUNE_IMC_SOURCE_PREDICATE_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/IMC/Message.hpp>
+
+namespace DUNE
+{
+  namespace IMC
+  {
+    //! Predicate on the source system and source entity of a
+    //! message. Predicates are attached to message bindings and
+    //! evaluated by the message bus before a message is queued, so
+    //! that recipients do not pay for messages they would discard.
+    class SourcePredicate
+    {
+    public:
+      //! Construct a predicate that matches any source.
+      SourcePredicate(void):
+        m_system(0),
+        m_entity(0),
+        m_any_system(true),
+        m_any_entity(true)
+      { }
+
+      //! Construct a predicate that matches messages originating
+      //! from a given entity of the local or any other system.
+      //! @param[in] entity source entity identifier.
+      //! @return predicate.
+      static SourcePredicate
+      fromEntity(unsigned entity)
+      {
+        SourcePredicate p;
+        p.m_entity = entity;
+        p.m_any_entity = false;
+        return p;
+      }
+
+      //! Construct a predicate that matches messages originating
+      //! from any entity of a given system.
+      //! @param[in] system source system identifier.
+      //! @return predicate.
+      static SourcePredicate
+      fromSystem(unsigned system)
+      {
+        SourcePredicate p;
+        p.m_system = system;
+        p.m_any_system = false;
+        return p;
+      }
+
+      //! Construct a predicate that matches messages originating
+      //! from a given entity of a given system.
+      //! @param[in] system source system identifier.
+      //! @param[in] entity source entity identifier.
+      //! @return predicate.
+      static SourcePredicate
+      fromSource(unsigned system, unsigned entity)
+      {
+        SourcePredicate p = fromEntity(entity);
+        p.m_system = system;
+        p.m_any_system = false;
+        return p;
+      }
+
+      //! Test if this predicate accepts every source.
+      //! @return true if any source is accepted, false otherwise.
+      bool
+      isAny(void) const
+      {
+        return m_any_system && m_any_entity;
+      }
+
+      //! Test if a message satisfies the predicate.
+      //! @param[in] msg message.
+      //! @return true if the message is accepted, false otherwise.
+      bool
+      match(const Message* msg) const
+      {
+        if (!m_any_system && msg->getSource() != m_system)
+          return false;
+
+        if (!m_any_entity && msg->getSourceEntity() != m_entity)
+          return false;
+
+        return true;
+      }
+
+      bool
+      operator==(const SourcePredicate& other) const
+      {
+        if (m_any_system != other.m_any_system || m_any_entity != other.m_any_entity)
+          return false;
+
+        if (!m_any_system && m_system != other.m_system)
+          return false;
+
+        if (!m_any_entity && m_entity != other.m_entity)
+          return false;
+
+        return true;
+      }
+
+    private:
+      //! Source system identifier.
+      unsigned m_system;
+      //! Source entity identifier.
+      unsigned m_entity;
+      //! True if any source system is accepted.
+      bool m_any_system;
+      //! True if any source entity is accepted.
+      bool m_any_entity;
+    };
+  }
+}
+
+#endif
@@ -47,6 +47,9 @@ namespace DUNE
     typedef HANDLE NativeHandle;
 #endif
 
+    //! Read time of data whose arrival time is not known.
+    static const double c_unknown_read_time = -1.0;
+
     class Handle
     {
     public:
@@ -116,6 +119,29 @@ namespace DUNE
         return rv;
       }
 
+      //! Retrieve the arrival time of the most recent byte returned
+      //! by the last read operation. Depending on the handle this is
+      //! a kernel time stamp or an estimate corrected for data still
+      //! buffered, and is therefore earlier than the time the read
+      //! returned. A read that returns no data resets it.
+      //! @return arrival time in seconds since the Unix Epoch, or
+      //! c_unknown_read_time if not known.
+      double
+      getLastReadTime(void) const
+      {
+        return doGetLastReadTime();
+      }
+
+      //! Record the time a poll reported data ready to be read.
+      //! Handles that estimate arrival times use it instead of the
+      //! time the next read returns.
+      //! @param[in] time time in seconds since the Unix Epoch.
+      void
+      setReadyTime(double time)
+      {
+        doSetReadyTime(time);
+      }
+
       //! Flush input and output.
       void
       flush(void)
@@ -155,6 +181,18 @@ namespace DUNE
       virtual size_t
       doRead(uint8_t* data, size_t data_size) = 0;
 
+      virtual double
+      doGetLastReadTime(void) const
+      {
+        return c_unknown_read_time;
+      }
+
+      virtual void
+      doSetReadyTime(double time)
+      {
+        (void)time;
+      }
+
       virtual void
       doFlushInput(void)
       { }
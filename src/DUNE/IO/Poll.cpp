@@ -34,6 +34,7 @@
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/System/Error.hpp>
+#include <DUNE/Time/Clock.hpp>
 #include <DUNE/Time/Constants.hpp>
 #include <DUNE/Time/Utils.hpp>
 #include <DUNE/IO/Poll.hpp>
@@ -79,12 +80,23 @@ namespace DUNE
       return false;
     }
 
+    bool
+    Poll::wasTriggered(Handle& handle)
+    {
+      if (!wasTriggered(handle.getNative()))
+        return false;
+
+      handle.setReadyTime(m_time);
+      return true;
+    }
+
     bool
     Poll::poll(double timeout)
     {
 #if defined(DUNE_OS_WINDOWS)
       DWORD count = m_handles.size();
       m_rv = WaitForMultipleObjects(count, &m_handles[0], FALSE, timeout * 1000);
+      m_time = Time::Clock::getSinceEpoch();
 
       if (m_rv < count)
       {
@@ -123,6 +135,8 @@ namespace DUNE
         rv = select(max + 1, &m_rfd, NULL, NULL, &tv);
       }
 
+      m_time = Time::Clock::getSinceEpoch();
+
       if (rv == -1)
       {
         //! Workaround for when we are interrupted by a signal.
@@ -171,5 +185,15 @@ namespace DUNE
       return rv > 0;
 #endif
     }
+
+    bool
+    Poll::poll(Handle& handle, double timeout)
+    {
+      if (!poll(handle.getNative(), timeout))
+        return false;
+
+      handle.setReadyTime(Time::Clock::getSinceEpoch());
+      return true;
+    }
   }
 }
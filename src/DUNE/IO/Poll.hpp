@@ -61,6 +61,14 @@ namespace DUNE
         return poll(handle.getNative(), timeout);
       }
 
+      //! Wait for data on an I/O handle and record the time the wait
+      //! returned as the handle's ready time.
+      //! @param[in] handle I/O handle.
+      //! @param[in] timeout timeout in seconds.
+      //! @return true if data is available, false otherwise.
+      static bool
+      poll(Handle& handle, double timeout);
+
       //! Add native I/O handle to the polling pool.
       //! @param[in] handle native I/O handle.
       void
@@ -99,6 +107,13 @@ namespace DUNE
         return wasTriggered(handle.getNative());
       }
 
+      //! Check if an I/O handle was triggered by the last poll and
+      //! record the time that poll returned as its ready time.
+      //! @param[in] handle I/O handle.
+      //! @return true if the handle was triggered, false otherwise.
+      bool
+      wasTriggered(Handle& handle);
+
     private:
       //! List of native I/O handles.
       std::vector<NativeHandle> m_handles;
@@ -107,6 +122,8 @@ namespace DUNE
 #elif defined(DUNE_OS_WINDOWS)
       DWORD m_rv;
 #endif
+      //! Time the last poll returned.
+      double m_time;
     };
   }
 }
@@ -46,6 +46,7 @@ namespace DUNE
     {
       bind<IMC::StopManeuver>(this);
       bind<IMC::PathControlState>(this);
+      bind<IMC::ControlLoops>(this, true);
     }
 
     Maneuver::~Maneuver(void)
@@ -72,29 +73,6 @@ namespace DUNE
       debug("disabling");
     }
 
-    void
-    Maneuver::updateLoops(const IMC::ControlLoops* cl)
-    {
-      while (1)
-      {
-        try
-        {
-          Concurrency::ScopedMutex l(s_amask_lock);
-
-          if (cl->enable == IMC::ControlLoops::CL_ENABLE)
-            s_amask |= cl->mask;
-          else
-            s_amask &= ~ cl->mask;
-
-          break;
-        }
-        catch (...)
-        {
-
-        }
-      }
-    }
-
     uint32_t
     Maneuver::changeScopeRef(void)
     {
@@ -164,6 +142,16 @@ namespace DUNE
       onPathControlState(pcs);
     }
 
+    void
+    Maneuver::consume(const IMC::ControlLoops* cl)
+    {
+      if (cl->enable != IMC::ControlLoops::CL_DISABLE)
+        return;
+
+      Concurrency::ScopedMutex l(s_amask_lock);
+      s_amask &= ~cl->mask;
+    }
+
     void
     Maneuver::signalError(const std::string& msg)
     {
@@ -214,26 +202,49 @@ namespace DUNE
     void
     Maneuver::setControl(uint32_t mask)
     {
-      if (mask == s_amask)
-        return;
+      uint32_t disable = 0;
+      uint32_t enable = 0;
 
-      IMC::ControlLoops cloops;
+      {
+        Concurrency::ScopedMutex l(s_amask_lock);
+
+        if (mask == s_amask)
+          return;
 
-      // Stop everything
-      cloops.enable = IMC::ControlLoops::CL_DISABLE;
-      cloops.mask = IMC::CL_ALL;
+        if (s_amask != 0 && (s_amask & ~mask) == 0)
+        {
+          // The new mask only adds loops: keep the previous ones.
+          enable = mask & ~s_amask;
+        }
+        else
+        {
+          // A loop is released: clear everything outside the new
+          // mask, including loops enabled by controllers on behalf of
+          // the previous maneuver, and enable the whole new mask so
+          // that controllers set up their dependent loops again.
+          disable = IMC::CL_ALL & ~mask;
+          enable = mask;
+        }
+
+        s_amask = mask;
+      }
+
+      // Both halves of the handoff share the same scope.
+      IMC::ControlLoops cloops;
       cloops.scope_ref = changeScopeRef();
-      dispatch(cloops);
-      updateLoops(&cloops);
 
-      if (mask)
+      if (disable)
+      {
+        cloops.enable = IMC::ControlLoops::CL_DISABLE;
+        cloops.mask = disable;
+        dispatch(cloops);
+      }
+
+      if (enable)
       {
-        // Enable controllers.
         cloops.enable = IMC::ControlLoops::CL_ENABLE;
-        cloops.mask = mask;
-        cloops.scope_ref = changeScopeRef();
+        cloops.mask = enable;
         dispatch(cloops);
-        updateLoops(&cloops);
       }
     }
 
@@ -166,7 +166,17 @@ namespace DUNE
       void
       consume(const IMC::PathControlState* pcs);
 
+      //! Consumer for ControlLoops message. Loops disabled by other
+      //! tasks (e.g. the vehicle supervisor) are no longer held.
+      //! @param cl message to consume.
+      void
+      consume(const IMC::ControlLoops* cl);
+
       //! Set or reconfigure control loops used by maneuver task.
+      //! When the new mask only adds loops to those held by the
+      //! previous maneuver, the held loops are left untouched and only
+      //! the new ones are enabled. Otherwise every loop outside the
+      //! new mask is disabled and the whole mask is enabled again.
       //! @param mask mask identifying controllers that should be made active.
       void
       setControl(uint32_t mask);
@@ -231,11 +241,6 @@ namespace DUNE
       onStateReport(void)
       { }
 
-      //! Update active control loops
-      //! @param cl control loops message
-      void
-      updateLoops(const IMC::ControlLoops* cl);
-
       //! Signal an error.
       //! This method should be used by subclasses to signal an error condition.
       //! @param msg error message
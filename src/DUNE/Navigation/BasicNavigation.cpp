@@ -52,6 +52,8 @@ namespace DUNE
       m_avg_heave(NULL),
       m_avg_gps(NULL)
     {
+      setDefaultCriticality(Tasks::CRITICALITY_HIGH);
+
       // Declare configuration parameters.
       param("Maximum Distance to Reference", m_max_dis2ref)
       .units(Units::Meter)
@@ -326,6 +328,14 @@ namespace DUNE
       {
         m_alt_eid = std::numeric_limits<unsigned>::max();
       }
+
+      // Let the message bus discard samples from other sensors.
+      setSource<IMC::Acceleration>(IMC::SourcePredicate::fromEntity(m_ahrs_eid));
+      setSource<IMC::AngularVelocity>(IMC::SourcePredicate::fromEntity(m_ahrs_eid));
+      setSource<IMC::EulerAngles>(IMC::SourcePredicate::fromEntity(m_ahrs_eid));
+      setSource<IMC::DepthOffset>(IMC::SourcePredicate::fromEntity(m_depth_eid));
+      setSource<IMC::DataSanity>(IMC::SourcePredicate::fromEntity(m_dvl_eid));
+      setSource<IMC::Distance>(IMC::SourcePredicate::fromEntity(m_alt_eid));
     }
 
     void
@@ -339,9 +349,6 @@ namespace DUNE
     void
     BasicNavigation::consume(const IMC::Acceleration* msg)
     {
-      if (msg->getSourceEntity() != m_ahrs_eid)
-        return;
-
       if (std::fabs(msg->x) > c_max_accel ||
           std::fabs(msg->y) > c_max_accel ||
           std::fabs(msg->z) > c_max_accel)
@@ -361,9 +368,6 @@ namespace DUNE
     void
     BasicNavigation::consume(const IMC::AngularVelocity* msg)
     {
-      if (msg->getSourceEntity() != m_ahrs_eid)
-        return;
-
       if (std::fabs(msg->x) > c_max_agvel ||
           std::fabs(msg->y) > c_max_agvel ||
           std::fabs(msg->z) > c_max_agvel)
@@ -397,18 +401,12 @@ namespace DUNE
     void
     BasicNavigation::consume(const IMC::DepthOffset* msg)
     {
-      if (msg->getSourceEntity() != m_depth_eid)
-        return;
-
       m_depth_offset = msg->value;
     }
 
     void
     BasicNavigation::consume(const IMC::DataSanity* msg)
     {
-      if (msg->getSourceEntity() != m_dvl_eid)
-        return;
-
       if (msg->sane == IMC::DataSanity::DS_NOT_SANE)
       {
         m_dvl_sanity_timer.reset();
@@ -423,9 +421,6 @@ namespace DUNE
     void
     BasicNavigation::consume(const IMC::Distance* msg)
     {
-      if (msg->getSourceEntity() != m_alt_eid)
-        return;
-
       if (msg->validity == IMC::Distance::DV_INVALID)
         return;
 
@@ -451,9 +446,6 @@ namespace DUNE
     void
     BasicNavigation::consume(const IMC::EulerAngles* msg)
     {
-      if (msg->getSourceEntity() != m_ahrs_eid)
-        return;
-
       if (std::fabs(msg->phi) > Math::c_pi ||
           std::fabs(msg->theta) > Math::c_pi ||
           std::fabs(msg->psi) > Math::c_pi)
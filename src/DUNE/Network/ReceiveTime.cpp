@@ -0,0 +1,125 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cstring>
+
+// DUNE headers.
+#include <DUNE/Network/ReceiveTime.hpp>
+
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_SYS_TIME_H)
+#  include <sys/time.h>
+#endif
+
+namespace DUNE
+{
+  namespace Network
+  {
+#if defined(DUNE_SOCKET_RX_TIMESTAMPS)
+    bool
+    ReceiveTime::enable(int handle, bool enabled)
+    {
+      int on = enabled ? 1 : 0;
+#  if defined(SO_TIMESTAMPNS)
+      return setsockopt(handle, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on)) == 0;
+#  else
+      return setsockopt(handle, SOL_SOCKET, SO_TIMESTAMP, &on, sizeof(on)) == 0;
+#  endif
+    }
+
+    void
+    ReceiveTime::prepare(msghdr& hdr, iovec& iov, void* bfr, size_t size, Control& control)
+    {
+      iov.iov_base = bfr;
+      iov.iov_len = size;
+
+      std::memset(&hdr, 0, sizeof(hdr));
+      hdr.msg_iov = &iov;
+      hdr.msg_iovlen = 1;
+      hdr.msg_control = control.data;
+      hdr.msg_controllen = sizeof(control.data);
+    }
+
+    ssize_t
+    ReceiveTime::receive(int handle, void* bfr, size_t size, int flags,
+                         void* name, socklen_t* name_len, double& time)
+    {
+      iovec iov;
+      msghdr hdr;
+      Control control;
+      prepare(hdr, iov, bfr, size, control);
+
+      if (name != NULL && name_len != NULL)
+      {
+        hdr.msg_name = name;
+        hdr.msg_namelen = *name_len;
+      }
+
+      ssize_t rv = recvmsg(handle, &hdr, flags);
+      time = (rv > 0) ? get(&hdr) : IO::c_unknown_read_time;
+
+      if (rv >= 0 && name != NULL && name_len != NULL)
+        *name_len = hdr.msg_namelen;
+
+      return rv;
+    }
+
+    double
+    ReceiveTime::get(msghdr* hdr)
+    {
+      for (cmsghdr* cmsg = CMSG_FIRSTHDR(hdr); cmsg != NULL; cmsg = CMSG_NXTHDR(hdr, cmsg))
+      {
+        if (cmsg->cmsg_level != SOL_SOCKET)
+          continue;
+
+#  if defined(SCM_TIMESTAMPNS)
+        if (cmsg->cmsg_type == SCM_TIMESTAMPNS)
+        {
+          timespec ts;
+          std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+          return ts.tv_sec + ts.tv_nsec / 1e9;
+        }
+#  endif
+
+#  if defined(SCM_TIMESTAMP)
+        if (cmsg->cmsg_type == SCM_TIMESTAMP)
+        {
+          timeval tv;
+          std::memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+          return tv.tv_sec + tv.tv_usec / 1e6;
+        }
+#  endif
+      }
+
+      return IO::c_unknown_read_time;
+    }
+#endif
+  }
+}
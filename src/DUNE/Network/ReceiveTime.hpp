@@ -0,0 +1,112 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef DUNE_NETWORK_RECEIVE_TIME_HPP_INCLUDED_
+#define DUNE_NETWORK_RECEIVE_TIME_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <ctime>
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+#include <DUNE/IO/Handle.hpp>
+
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_SYS_TYPES_H)
+#  include <sys/types.h>
+#endif
+
+#if defined(DUNE_SYS_HAS_SYS_SOCKET_H)
+#  include <sys/socket.h>
+#endif
+
+#if defined(DUNE_OS_POSIX) && (defined(SO_TIMESTAMPNS) || defined(SO_TIMESTAMP))
+#  define DUNE_SOCKET_RX_TIMESTAMPS 1
+#endif
+
+namespace DUNE
+{
+  namespace Network
+  {
+    //! Kernel receive time stamps of socket data. This is an internal
+    //! helper of the socket handles and is not part of the public
+    //! networking interface.
+    class ReceiveTime
+    {
+    public:
+#if defined(DUNE_SOCKET_RX_TIMESTAMPS)
+      //! Control buffer large enough for one receive time stamp.
+      union Control
+      {
+        cmsghdr header;
+        char data[CMSG_SPACE(sizeof(timespec))];
+      };
+
+      //! Enable/disable kernel receive time stamps of a socket.
+      //! @param[in] handle socket.
+      //! @param[in] enabled true to enable, false to disable.
+      //! @return true if successful, false otherwise.
+      static bool
+      enable(int handle, bool enabled);
+
+      //! Prepare a message header to receive data into one buffer
+      //! along with its time stamp.
+      //! @param[out] hdr message header.
+      //! @param[out] iov I/O vector.
+      //! @param[in] bfr destination buffer.
+      //! @param[in] size destination buffer size.
+      //! @param[in] control control buffer.
+      static void
+      prepare(msghdr& hdr, iovec& iov, void* bfr, size_t size, Control& control);
+
+      //! Receive data and its kernel time stamp.
+      //! @param[in] handle socket.
+      //! @param[in] bfr destination buffer.
+      //! @param[in] size destination buffer size.
+      //! @param[in] flags receive flags.
+      //! @param[out] name source address (may be NULL).
+      //! @param[in,out] name_len source address length (may be NULL).
+      //! @param[out] time time stamp or IO::c_unknown_read_time.
+      //! @return number of bytes received or -1 on error.
+      static ssize_t
+      receive(int handle, void* bfr, size_t size, int flags,
+              void* name, socklen_t* name_len, double& time);
+
+      //! Extract the kernel receive time stamp from a received message.
+      //! @param[in] hdr message header.
+      //! @return time stamp or IO::c_unknown_read_time if not present.
+      static double
+      get(msghdr* hdr);
+#endif
+    };
+  }
+}
+
+#endif
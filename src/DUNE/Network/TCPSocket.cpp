@@ -39,7 +39,9 @@
 #include <DUNE/Utils/ByteCopy.hpp>
 #include <DUNE/Network/TCPSocket.hpp>
 #include <DUNE/Network/Exceptions.hpp>
+#include <DUNE/Network/ReceiveTime.hpp>
 #include <DUNE/Time/Utils.hpp>
+#include <DUNE/Time/Clock.hpp>
 #include <DUNE/Concurrency/Scheduler.hpp>
 #include <DUNE/IO/Poll.hpp>
 
@@ -122,7 +124,9 @@ namespace DUNE
   namespace Network
   {
     TCPSocket::TCPSocket(bool create):
-      m_handle(INVALID_SOCKET)
+      m_handle(INVALID_SOCKET),
+      m_rx_stamps(false),
+      m_read_time(IO::c_unknown_read_time)
     {
       if (create)
       {
@@ -216,7 +220,20 @@ namespace DUNE
     size_t
     TCPSocket::doRead(uint8_t* bfr, size_t size)
     {
-      ssize_t rv = ::recv(m_handle, (char*)bfr, size, 0);
+      ssize_t rv = 0;
+      m_read_time = IO::c_unknown_read_time;
+
+#if defined(DUNE_SOCKET_RX_TIMESTAMPS)
+      if (m_rx_stamps)
+      {
+        rv = ReceiveTime::receive(m_handle, bfr, size, 0, NULL, NULL, m_read_time);
+      }
+      else
+#endif
+      {
+        rv = ::recv(m_handle, (char*)bfr, size, 0);
+      }
+
       if (rv == 0)
       {
         throw ConnectionClosed();
@@ -228,6 +245,9 @@ namespace DUNE
         throw NetworkError(DTR("error receiving data"), getLastErrorMessage());
       }
 
+      if (m_read_time < 0)
+        m_read_time = Time::Clock::getSinceEpoch();
+
       return static_cast<size_t>(rv);
     }
 
@@ -340,6 +360,21 @@ namespace DUNE
       setsockopt(m_handle, IPPROTO_TCP, TCP_NODELAY, (char*)&set, sizeof(set));
     }
 
+    bool
+    TCPSocket::enableReceiveTimestamps(bool enabled)
+    {
+#if defined(DUNE_SOCKET_RX_TIMESTAMPS)
+      if (!ReceiveTime::enable(m_handle, enabled))
+        return false;
+
+      m_rx_stamps = enabled;
+      return true;
+#else
+      (void)enabled;
+      return false;
+#endif
+    }
+
     void
     TCPSocket::setReceiveTimeout(double timeout)
     {
@@ -90,6 +90,14 @@ namespace DUNE
       void
       setNoDelay(bool enabled);
 
+      //! Enable/disable kernel receive time stamps. When enabled,
+      //! getLastReadTime() returns the time the data reached the
+      //! network stack instead of the time the read returned.
+      //! @param[in] enabled true to enable, false to disable.
+      //! @return true if supported, false otherwise.
+      bool
+      enableReceiveTimestamps(bool enabled);
+
       //! Set the timeout value that specifies the maximum amount of
       //! time an input function waits until it completes.
       //! @param[in] timeout timeout value in second.
@@ -117,6 +125,10 @@ namespace DUNE
 #else
       int m_handle;
 #endif
+      //! True if kernel receive time stamps are enabled.
+      bool m_rx_stamps;
+      //! Arrival time of the last data read.
+      double m_read_time;
 
       IO::NativeHandle
       doGetNative(void) const;
@@ -124,6 +136,12 @@ namespace DUNE
       size_t
       doRead(uint8_t* buffer, size_t size);
 
+      double
+      doGetLastReadTime(void) const
+      {
+        return m_read_time;
+      }
+
       size_t
       doWrite(const uint8_t* bfr, size_t size);
 
@@ -29,13 +29,16 @@
 
 // ISO C++ 98 headers.
 #include <cerrno>
+#include <cstring>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Network/Address.hpp>
 #include <DUNE/Network/UDPSocket.hpp>
 #include <DUNE/Network/Exceptions.hpp>
+#include <DUNE/Network/ReceiveTime.hpp>
 #include <DUNE/Utils/ByteCopy.hpp>
+#include <DUNE/Time/Clock.hpp>
 
 // Win32 headers.
 #if defined(DUNE_SYS_HAS_WINSOCK2_H)
@@ -94,7 +97,9 @@ namespace DUNE
   namespace Network
   {
     UDPSocket::UDPSocket(void):
-      m_con_port(0)
+      m_con_port(0),
+      m_rx_stamps(false),
+      m_read_time(IO::c_unknown_read_time)
     {
       //  POSIX / Win32
 #if defined(DUNE_SYS_HAS_SOCKET)
@@ -136,6 +141,21 @@ namespace DUNE
 #endif
     }
 
+    bool
+    UDPSocket::enableReceiveTimestamps(bool enabled)
+    {
+#if defined(DUNE_SOCKET_RX_TIMESTAMPS)
+      if (!ReceiveTime::enable(m_handle, enabled))
+        return false;
+
+      m_rx_stamps = enabled;
+      return true;
+#else
+      (void)enabled;
+      return false;
+#endif
+    }
+
     void
     UDPSocket::enableBroadcast(bool value)
     {
@@ -186,6 +206,17 @@ namespace DUNE
         throw NetworkError(DTR("unable to bind to socket"), DUNE_SOCKET_ERROR);
     }
 
+    uint16_t
+    UDPSocket::getBoundPort(void)
+    {
+      sockaddr_in name = {0};
+      socklen_t size = sizeof(name);
+      if (getsockname(m_handle, (sockaddr*)&name, &size) != 0)
+        throw NetworkError(DTR("unable to get bound port"), DUNE_SOCKET_ERROR);
+
+      return Utils::ByteCopy::fromBE(name.sin_port);
+    }
+
     size_t
     UDPSocket::read(uint8_t* buffer, size_t size, Address* addr, uint16_t* port)
     {
@@ -193,11 +224,26 @@ namespace DUNE
       socklen_t sock_len = sizeof(host);
       std::memset((char*)&host, 0, sock_len);
 
-      int rv = recvfrom(m_handle, (char*)buffer, size, 0, (::sockaddr*)&host, (::socklen_t*)&sock_len);
+      int rv = 0;
+      m_read_time = IO::c_unknown_read_time;
+
+#if defined(DUNE_SOCKET_RX_TIMESTAMPS)
+      if (m_rx_stamps)
+      {
+        rv = ReceiveTime::receive(m_handle, buffer, size, 0, &host, &sock_len, m_read_time);
+      }
+      else
+#endif
+      {
+        rv = recvfrom(m_handle, (char*)buffer, size, 0, (::sockaddr*)&host, (::socklen_t*)&sock_len);
+      }
 
       if (rv <= 0)
         throw NetworkError(DTR("error receiving data"), DUNE_SOCKET_ERROR);
 
+      if (m_read_time < 0)
+        m_read_time = Time::Clock::getSinceEpoch();
+
       if (addr != NULL)
         *addr = (::sockaddr*)&host;
 
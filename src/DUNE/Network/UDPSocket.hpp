@@ -69,10 +69,23 @@ namespace DUNE
       void
       joinMulticastGroup(Address group, Address itf = Address::Any);
 
+      //! Enable/disable kernel receive time stamps. When enabled,
+      //! getLastReadTime() returns the time the data reached the
+      //! network stack instead of the time the read returned.
+      //! @param[in] enabled true to enable, false to disable.
+      //! @return true if supported, false otherwise.
+      bool
+      enableReceiveTimestamps(bool enabled);
+
       //! Assign a name to a socket.
       void
       bind(uint16_t port = 0, Address add = Address::Any, bool reuse = true);
 
+      //! Retrieve the port the socket is bound to.
+      //! @return port number.
+      uint16_t
+      getBoundPort(void);
+
       void
       connect(const Address& addr, uint16_t port)
       {
@@ -110,6 +123,10 @@ namespace DUNE
       Address m_con_addr;
       //! Connected port.
       unsigned m_con_port;
+      //! True if kernel receive time stamps are enabled.
+      bool m_rx_stamps;
+      //! Arrival time of the last datagram read.
+      double m_read_time;
 
       IO::NativeHandle
       doGetNative(void) const
@@ -133,6 +150,12 @@ namespace DUNE
         return read(data, data_size, NULL, NULL);
       }
 
+      double
+      doGetLastReadTime(void) const
+      {
+        return m_read_time;
+      }
+
       void
       createEventHandle(void);
 
@@ -92,6 +92,17 @@ namespace DUNE
       return toWh(itr->second, duration);
     }
 
+    float
+    Model::getPayloadPower(const std::string& label) const
+    {
+      std::map<std::string, float>::const_iterator itr;
+      itr = m_payloads.find(label);
+      if (itr == m_payloads.end())
+        return 0.0;
+
+      return itr->second;
+    }
+
     float
     Model::computeHotelEnergy(float duration) const
     {
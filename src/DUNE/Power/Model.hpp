@@ -83,6 +83,12 @@ namespace DUNE
       float
       computeIMUEnergy(float duration) const;
 
+      //! Get the power consumed by a payload entity
+      //! @param[in] label name of the payload
+      //! @return power in W, 0 if the payload is unknown
+      float
+      getPayloadPower(const std::string& label) const;
+
       //! Get the battery capacity
       //! @return battery energy capacity in Wh
       inline float
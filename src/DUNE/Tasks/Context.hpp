@@ -42,6 +42,7 @@
 #include <DUNE/Tasks/Profiles.hpp>
 #include <DUNE/IMC/Bus.hpp>
 #include <DUNE/IMC/AddressResolver.hpp>
+#include <DUNE/IMC/DuplicateFilter.hpp>
 
 namespace DUNE
 {
@@ -64,6 +65,9 @@ namespace DUNE
       IMC::Bus mbus;
       //! IMC address resolver.
       IMC::AddressResolver resolver;
+      //! Messages recently received by transports, shared so that
+      //! copies arriving over different links are dropped.
+      IMC::DuplicateFilter duplicates;
       //! Label data base.
       Entities::EntityDataBase entities;
       //! Execution profiles.
@@ -47,6 +47,10 @@ namespace DUNE
   namespace Tasks
   {
     static const int c_high_task_cpu_usage = 10;
+    //! Maximum governor level.
+    static const unsigned c_gov_max_level = 4;
+    //! Governor level above which tasks of normal criticality are throttled.
+    static const unsigned c_gov_normal_level = 2;
 
     struct TaskCpuUsage
     {
@@ -63,7 +67,8 @@ namespace DUNE
     };
 
     Manager::Manager(Context& ctx):
-      m_ctx(ctx)
+      m_ctx(ctx),
+      m_gov_level(0)
     {
       // Get all sections.
       std::vector<std::string> vec = m_ctx.config.sections();
@@ -224,7 +229,7 @@ namespace DUNE
         m_task_cpu_usage.value = value;
         task->dispatch(m_task_cpu_usage);
 
-        if (value >= c_high_task_cpu_usage)
+        if (value >= c_high_task_cpu_usage && task->getCriticality() != CRITICALITY_HIGH)
         {
           TaskCpuUsage entry;
           entry.usage = value;
@@ -263,5 +268,66 @@ namespace DUNE
         task->war(DTR("using %d%% of CPU, failed to lower the priority"), cpu_usage);
       }
     }
+
+    unsigned
+    Manager::governRates(bool overloaded, bool relaxed)
+    {
+      bool missed = false;
+      bool throttleable = false;
+
+      std::map<std::string, Task*>::const_iterator itr = m_tasks.begin();
+      for ( ; itr != m_tasks.end(); ++itr)
+      {
+        Task* task = itr->second;
+        unsigned misses = task->getDeadlineMisses();
+
+        if (task->getCriticality() != CRITICALITY_LOW && misses != m_misses[task])
+          missed = true;
+
+        if (task->getCriticality() != CRITICALITY_HIGH && task->isThrottleable())
+          throttleable = true;
+
+        m_misses[task] = misses;
+      }
+
+      unsigned level = m_gov_level;
+
+      // Escalating is pointless when no task can slow down.
+      if ((overloaded || missed) && throttleable)
+        level = std::min(level + 1, c_gov_max_level);
+      else if (relaxed && level > 0)
+        --level;
+
+      if (level == m_gov_level)
+        return m_gov_level;
+
+      m_gov_level = level;
+
+      for (itr = m_tasks.begin(); itr != m_tasks.end(); ++itr)
+        itr->second->setThrottle(getThrottle(itr->second));
+
+      return m_gov_level;
+    }
+
+    float
+    Manager::getThrottle(const Task* task) const
+    {
+      unsigned halvings = 0;
+
+      switch (task->getCriticality())
+      {
+        case CRITICALITY_LOW:
+          halvings = m_gov_level;
+          break;
+        case CRITICALITY_NORMAL:
+          if (m_gov_level > c_gov_normal_level)
+            halvings = m_gov_level - c_gov_normal_level;
+          break;
+        case CRITICALITY_HIGH:
+          break;
+      }
+
+      return 1.0f / (float)(1 << halvings);
+    }
   }
 }
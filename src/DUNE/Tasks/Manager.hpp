@@ -110,6 +110,19 @@ namespace DUNE
       void
       adjustPriorities(void);
 
+      //! Scale the workload of non-critical tasks to the system
+      //! load. Each call moves the governor at most one level: up
+      //! when the system is overloaded or a task of normal or high
+      //! criticality missed a deadline, down when the system is
+      //! relaxed. The governor stays idle when no task of normal or
+      //! low criticality can be throttled.
+      //! @param[in] overloaded true if CPU usage is above maximum.
+      //! @param[in] relaxed true if CPU usage is low enough to restore
+      //! throttled tasks.
+      //! @return governor level, zero when no task is throttled.
+      unsigned
+      governRates(bool overloaded, bool relaxed);
+
     private:
       struct TaskCpuUsage
       {
@@ -135,12 +148,22 @@ namespace DUNE
       std::priority_queue<TaskCpuUsage> m_cpu_usage_hogs;
       //! Buffer message to dispatch CPU usage of tasks.
       IMC::CpuUsage m_task_cpu_usage;
+      //! Current governor level.
+      unsigned m_gov_level;
+      //! Deadline misses of each task at the last governor step.
+      std::map<Task*, unsigned> m_misses;
 
       void
       createTask(const std::string& section);
 
       void
       lowerHogPriority(Task* task, int cpu_usage);
+
+      //! Compute throttle factor of a task for the current governor level.
+      //! @param[in] task task object.
+      //! @return throttle factor.
+      float
+      getThrottle(const Task* task) const;
     };
   }
 }
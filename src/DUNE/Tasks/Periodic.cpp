@@ -30,6 +30,7 @@
 // ISO C++ 98 headers.
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 
 // DUNE headers.
 #include <DUNE/IMC/Bus.hpp>
@@ -37,6 +38,7 @@
 #include <DUNE/Tasks/Periodic.hpp>
 #include <DUNE/Time/Clock.hpp>
 #include <DUNE/Time/Delay.hpp>
+#include <DUNE/Time/TimerWheel.hpp>
 
 namespace DUNE
 {
@@ -45,33 +47,90 @@ namespace DUNE
     Periodic::Periodic(const std::string& name, Context& ctx):
       Task(name, ctx),
       m_run_count(0),
-      m_run_time(0)
+      m_run_time(0),
+      m_inline_next(-1.0)
     {
       param(DTR_RT("Execution Frequency"), m_frequency)
       .units(Units::Hertz)
       .defaultValue("1.0")
       .description(DTR("Frequency at which task is executed"));
+
+      param(DTR_RT("Minimum Execution Frequency"), m_min_frequency)
+      .units(Units::Hertz)
+      .defaultValue("0.0")
+      .minimumValue("0.0")
+      .description(DTR("Lowest frequency the task may be slowed down to "
+                       "when the system is overloaded, zero to never "
+                       "slow it down"));
+
+      param(DTR_RT("Execution Slack"), m_slack)
+      .units(Units::Second)
+      .defaultValue("0.0")
+      .minimumValue("0.0")
+      .description(DTR("Tolerated lateness of each execution, allowing "
+                       "wake-ups to be shared with other tasks"));
+    }
+
+    double
+    Periodic::getScaledFrequency(void) const
+    {
+      if (m_min_frequency <= 0 || m_min_frequency >= m_frequency)
+        return m_frequency;
+
+      return std::max(m_min_frequency, m_frequency * getThrottle());
+    }
+
+    bool
+    Periodic::stepInline(double now)
+    {
+      consumeMessages();
+
+      double frequency = getScaledFrequency();
+      if (frequency <= 0)
+        return false;
+
+      if (m_inline_next >= 0 && now < m_inline_next)
+        return false;
+
+      if (m_inline_next < 0 || now - m_inline_next > 1.0 / frequency)
+        m_inline_next = now;
+
+      m_inline_next += 1.0 / frequency;
+      m_run_time = now;
+      task();
+      ++m_run_count;
+      return true;
     }
 
     void
     Periodic::onMain(void)
     {
       double now = Time::Clock::get();
-      double delay = (1 / m_frequency);
+      double delay = (1.0 / getScaledFrequency());
       double next_inv = now + delay;
       m_run_time = now;
 
       while (!stopping())
       {
-        delay = (1.0 / m_frequency);
+        delay = (1.0 / getScaledFrequency());
 
+        // Without slack there is nothing to share: skip the registry.
         if (next_inv > now)
-          Time::Delay::wait(next_inv - now);
+        {
+          if (m_slack > 0)
+            Time::Delay::wait(Time::TimerWheel::schedule(next_inv, m_slack) - now);
+          else
+            Time::Delay::wait(next_inv - now);
+        }
 
         next_inv += delay;
         now = Time::Clock::get();
         m_run_time = now;
 
+        // Starting after the next execution instant is a deadline miss.
+        if (now > next_inv + m_slack)
+          signalDeadlineMiss();
+
         // Perform job.
         consumeMessages();
         if (!stopping())
@@ -79,6 +79,15 @@ namespace DUNE
         return m_frequency;
       }
 
+      //! Check if the task can be slowed down, which requires a
+      //! minimum frequency below its nominal frequency.
+      //! @return true if the task can be throttled, false otherwise.
+      bool
+      isThrottleable(void) const
+      {
+        return m_min_frequency > 0 && m_min_frequency < m_frequency;
+      }
+
       //! Retrieve the time of the last run (monotonic clock).
       //! @return time of last run.
       inline double
@@ -99,6 +108,13 @@ namespace DUNE
       virtual void
       task(void) = 0;
 
+      //! Consume queued messages and run the task's body if the
+      //! harness time reached the next execution instant.
+      //! @param[in] now harness time in seconds.
+      //! @return true if the task's body ran, false otherwise.
+      bool
+      stepInline(double now);
+
     private:
       //! Number of executions thus far.
       unsigned m_run_count;
@@ -106,6 +122,18 @@ namespace DUNE
       double m_run_time;
       //! Task frequency (Hz).
       double m_frequency;
+      //! Lowest frequency when throttled (Hz).
+      double m_min_frequency;
+      //! Tolerated lateness of each execution (s).
+      double m_slack;
+      //! Next execution instant when driven inline (harness time).
+      double m_inline_next;
+
+      //! Compute the frequency at which the task should run, taking
+      //! the current throttle factor into account.
+      //! @return execution frequency in Hertz.
+      double
+      getScaledFrequency(void) const;
 
       //! Task entry point.
       void
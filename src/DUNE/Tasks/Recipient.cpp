@@ -28,6 +28,7 @@
 //***************************************************************************
 
 // ISO C++ 98 headers.
+#include <algorithm>
 #include <cstddef>
 
 // DUNE headers.
@@ -60,27 +61,66 @@ namespace DUNE
     void
     Recipient::unbindAll(void)
     {
-      std::map<uint32_t, std::vector<AbstractConsumer*> >::iterator itr = m_cbacks.begin();
+      std::map<uint32_t, std::vector<Binding> >::iterator itr = m_cbacks.begin();
 
       for (; itr != m_cbacks.end(); ++itr)
       {
         m_ctx.mbus.unregisterRecipient(m_task, itr->first);
 
         for (size_t i = 0; i < itr->second.size(); ++i)
-          delete itr->second[i];
+          delete itr->second[i].consumer;
 
         itr->second.clear();
       }
     }
 
     void
-    Recipient::bind(uint32_t id, AbstractConsumer* consumer)
+    Recipient::bind(uint32_t id, AbstractConsumer* consumer, const IMC::SourcePredicate& source)
     {
-      std::map<uint32_t, std::vector<AbstractConsumer*> >::iterator itr = m_cbacks.find(id);
+      std::map<uint32_t, std::vector<Binding> >::iterator itr = m_cbacks.find(id);
       if (itr == m_cbacks.end())
         m_ctx.mbus.registerRecipient(m_task, id);
 
-      m_cbacks[id].push_back(consumer);
+      Binding binding;
+      binding.consumer = consumer;
+      binding.source = source;
+      m_cbacks[id].push_back(binding);
+      updateSources(id);
+    }
+
+    void
+    Recipient::setSource(uint32_t id, const IMC::SourcePredicate& source)
+    {
+      std::map<uint32_t, std::vector<Binding> >::iterator itr = m_cbacks.find(id);
+      if (itr == m_cbacks.end())
+        return;
+
+      for (size_t i = 0; i < itr->second.size(); ++i)
+        itr->second[i].source = source;
+
+      updateSources(id);
+    }
+
+    void
+    Recipient::updateSources(uint32_t id)
+    {
+      std::vector<Binding>& bindings = m_cbacks[id];
+      std::vector<IMC::SourcePredicate> sources;
+
+      for (size_t i = 0; i < bindings.size(); ++i)
+      {
+        // One unrestricted consumer is enough to accept any source.
+        if (bindings[i].source.isAny())
+        {
+          sources.clear();
+          break;
+        }
+
+        if (std::find(sources.begin(), sources.end(), bindings[i].source) == sources.end())
+          sources.push_back(bindings[i].source);
+      }
+
+      m_ctx.mbus.setRecipientSources(m_task, id, sources);
     }
 
     void
@@ -90,6 +130,12 @@ namespace DUNE
         runCallBacks();
     }
 
+    void
+    Recipient::interrupt(void)
+    {
+      m_mqueue.push(NULL);
+    }
+
     void
     Recipient::put(const IMC::Message* msg)
     {
@@ -106,9 +152,12 @@ namespace DUNE
         const IMC::Message* msg = m_mqueue.pop();
         if (msg)
         {
-          uint32_t id = msg->getId();
-          for (size_t j = 0; j < m_cbacks[id].size(); ++j)
-            m_cbacks[id][j]->consume(msg);
+          std::vector<Binding>& bindings = m_cbacks[msg->getId()];
+          for (size_t j = 0; j < bindings.size(); ++j)
+          {
+            if (bindings[j].source.match(msg))
+              bindings[j].consumer->consume(msg);
+          }
           delete msg;
         }
       }
@@ -38,6 +38,7 @@
 #include <DUNE/Concurrency/TSQueue.hpp>
 #include <DUNE/Tasks/Consumer.hpp>
 #include <DUNE/Tasks/AbstractTask.hpp>
+#include <DUNE/IMC/SourcePredicate.hpp>
 
 namespace DUNE
 {
@@ -64,24 +65,67 @@ namespace DUNE
       void
       put(const IMC::Message*);
 
+      //! Register a consumer for a given message identifier.
+      //! @param id message identifier.
+      //! @param c consumer object.
+      //! @param source messages not satisfying this predicate are
+      //! discarded by the message bus and never reach the consumer.
       void
-      bind(uint32_t id, AbstractConsumer* c);
+      bind(uint32_t id, AbstractConsumer* c,
+           const IMC::SourcePredicate& source = IMC::SourcePredicate());
+
+      //! Change the accepted sources of all consumers of a given
+      //! message identifier.
+      //! @param id message identifier.
+      //! @param source messages not satisfying this predicate are
+      //! discarded by the message bus and never reach the consumers.
+      void
+      setSource(uint32_t id, const IMC::SourcePredicate& source);
 
       void
       waitForMessages(double timeout);
 
+      //! Wake up a thread blocked in waitForMessages(), even if no
+      //! message is available. The wake-up is not lost if no thread
+      //! is currently waiting.
+      void
+      interrupt(void);
+
       void
       runCallBacks(void);
 
+      //! Retrieve the number of messages waiting to be consumed.
+      //! @return number of queued messages.
+      unsigned
+      getQueueSize(void)
+      {
+        return m_mqueue.size();
+      }
+
     private:
+      //! Consumer and its accepted sources.
+      struct Binding
+      {
+        //! Consumer.
+        AbstractConsumer* consumer;
+        //! Accepted sources.
+        IMC::SourcePredicate source;
+      };
+
       //! Task.
       AbstractTask* m_task;
       //! Context.
       Context& m_ctx;
       //! Callbacks.
-      std::map<uint32_t, std::vector<AbstractConsumer*> > m_cbacks;
+      std::map<uint32_t, std::vector<Binding> > m_cbacks;
       //! Message queue.
       Concurrency::TSQueue<IMC::Message*> m_mqueue;
+
+      //! Publish to the message bus the union of the accepted
+      //! sources of all consumers of a message identifier.
+      //! @param id message identifier.
+      void
+      updateSources(uint32_t id);
     };
   }
 }
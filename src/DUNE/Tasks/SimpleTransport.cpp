@@ -58,6 +58,10 @@ namespace DUNE
       param("Trace - Outgoing Messages", m_gargs.trace_out)
       .defaultValue("false")
       .description("Enable verbose output regarding outgoing messages");
+
+      param("Filter Duplicates", m_gargs.filter_dups)
+      .defaultValue("true")
+      .description("Drop incoming messages already received over another link");
     }
 
     SimpleTransport::~SimpleTransport(void)
@@ -107,6 +111,14 @@ namespace DUNE
 
         if (m)
         {
+          if (m_gargs.filter_dups
+              && !m_ctx.duplicates.accept(m, parser.getPayload(), parser.getPayloadSize(),
+                                          Time::Clock::get()))
+          {
+            delete m;
+            continue;
+          }
+
           dispatch(m, DF_KEEP_TIME | DF_KEEP_SRC_EID);
 
           if (m_gargs.trace_in)
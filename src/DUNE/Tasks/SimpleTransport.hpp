@@ -83,6 +83,8 @@ namespace DUNE
         bool trace_in;
         // Trace outgoing messages.
         bool trace_out;
+        // Drop messages already received over another link.
+        bool filter_dups;
       };
       GArguments m_gargs;
       Utils::ByteBuffer m_buf;
@@ -31,6 +31,8 @@
 // ISO C++ 98 headers.
 #include <sstream>
 #include <cstddef>
+#include <cmath>
+#include <algorithm>
 
 // DUNE headers.
 #include <DUNE/IMC/Constants.hpp>
@@ -42,6 +44,7 @@
 #include <DUNE/Tasks/Context.hpp>
 #include <DUNE/Tasks/Exceptions.hpp>
 #include <DUNE/Tasks/Task.hpp>
+#include <DUNE/Utils/String.hpp>
 #include <DUNE/Utils/XML.hpp>
 #include <DUNE/Entities/BasicEntity.hpp>
 #include <DUNE/Entities/EntityUtils.hpp>
@@ -56,6 +59,12 @@ namespace DUNE
   {
     //! Maximum size of a log book entry message.
     const static size_t c_log_message_max_size = 1024;
+    //! Activations measured before the statistics are trusted.
+    const static unsigned c_act_stats_min_samples = 3;
+    //! Minimum weight of a new activation time measurement.
+    const static double c_act_stats_weight = 0.2;
+    //! Number of standard deviations of margin on activation time.
+    const static double c_act_stats_sigmas = 2.0;
 
     Task::Task(const std::string& n, Context& ctx):
       m_ctx(ctx),
@@ -63,12 +72,16 @@ namespace DUNE
       m_name(n),
       m_entity(NULL),
       m_debug_level(DEBUG_LEVEL_NONE),
+      m_criticality(CRITICALITY_NORMAL),
+      m_throttle(1.0f),
+      m_deadline_misses(0),
       m_honours_active(false)
     {
       m_args.priority = 10;
       m_args.act_time = 0;
       m_args.deact_time = 0;
       m_args.active = false;
+      m_act_start = -1.0;
 
       param(DTR_RT("Entity Label"), m_args.elabel)
       .defaultValue("")
@@ -78,12 +91,25 @@ namespace DUNE
       .defaultValue("10")
       .description(DTR("Execution priority"));
 
+      param(DTR_RT("Criticality"), m_args.criticality)
+      .defaultValue("Normal")
+      .values("High, Normal, Low")
+      .description(DTR("Criticality class, tasks of lower criticality are "
+                       "slowed down first when the system is overloaded"));
+
       param(DTR_RT("Activation Time"), m_args.act_time)
       .defaultValue("0");
 
       param(DTR_RT("Deactivation Time"), m_args.deact_time)
       .defaultValue("0");
 
+      param(DTR_RT("Activation Time - Statistics"), m_args.act_stats)
+      .defaultValue("0, 0, 0")
+      .size(3)
+      .scope(Parameter::SCOPE_GLOBAL)
+      .description(DTR("Measured activation times: number of samples, "
+                       "mean (s) and variance (s^2)"));
+
       param(DTR_RT("Debug Level"), m_debug_level_string)
       .defaultValue("None")
       .values("None, Debug, Trace, Spew");
@@ -138,6 +164,78 @@ namespace DUNE
       onEntityResolution();
     }
 
+    uint16_t
+    Task::getExpectedActivationTime(void) const
+    {
+      if (m_args.act_time == 0 || m_args.act_stats[0] < c_act_stats_min_samples)
+        return m_args.act_time;
+
+      double sigma = std::sqrt(std::max(0.0, m_args.act_stats[2]));
+      double expected = std::ceil(m_args.act_stats[1] + c_act_stats_sigmas * sigma);
+      expected = std::max(1.0, std::min(expected, (double)m_args.act_time));
+
+      return (uint16_t)expected;
+    }
+
+    void
+    Task::reportActTimes(void)
+    {
+      m_entity->setActTimes(getExpectedActivationTime(), m_args.deact_time);
+      m_entity->reportInfo();
+    }
+
+    void
+    Task::updateActivationStatistics(double duration)
+    {
+      uint16_t previous = getExpectedActivationTime();
+      double count = m_args.act_stats[0] + 1;
+      double mean = m_args.act_stats[1];
+      double variance = m_args.act_stats[2];
+
+      // Running mean and variance that turn into exponentially
+      // weighted ones once enough samples are available.
+      double weight = std::max(1.0 / count, c_act_stats_weight);
+      double delta = duration - mean;
+      mean += weight * delta;
+      variance = (1.0 - weight) * (variance + weight * delta * delta);
+
+      std::string value = Utils::String::str("%0.0f, %0.3f, %0.4f", count, mean, variance);
+      m_params.set(DTR_RT("Activation Time - Statistics"), value);
+      m_ctx.config.set(getName(), DTR_RT("Activation Time - Statistics"), value);
+
+      debug("activation took %0.2f s (mean %0.2f s, variance %0.3f)",
+            duration, mean, variance);
+
+      // Saving rewrites the configuration file, so only do it while
+      // the statistics are still being established or when they move
+      // the expected activation time.
+      if (getExpectedActivationTime() != previous)
+        reportActTimes();
+      else if (count > c_act_stats_min_samples)
+        return;
+
+      // Persist the statistics alone: saving the whole entity would
+      // also persist the activation state and any transient values.
+      IMC::EntityParameter param;
+      param.name = DTR_RT("Activation Time - Statistics");
+      param.value = value;
+
+      IMC::EntityParameters save;
+      save.name = getEntityLabel();
+      save.params.push_back(param);
+
+      try
+      {
+        save.setDestination(getSystemId());
+        save.setDestinationEntity(resolveEntity("Daemon"));
+        dispatch(save);
+      }
+      catch (...)
+      {
+        // No daemon to keep saved parameters.
+      }
+    }
+
     void
     Task::reportEntityState(void)
     {
@@ -194,6 +292,33 @@ namespace DUNE
       }
     }
 
+    void
+    Task::bringUp(bool retry, bool force_activation)
+    {
+      resolveEntities();
+      releaseResources();
+      acquireResources();
+
+      if (retry)
+        initializeResources();
+      else
+        onResourceInitialization();
+
+      if (!m_honours_active)
+        return;
+
+      Parameter::Scope active_scope = Parameter::scopeFromString(m_args.active_scope);
+      bool idle_scope = (active_scope == Parameter::SCOPE_GLOBAL) || (active_scope == Parameter::SCOPE_IDLE);
+      if (force_activation || (m_args.active && idle_scope))
+        requestActivation();
+    }
+
+    void
+    Task::setupInline(bool force_activation)
+    {
+      bringUp(false, force_activation);
+    }
+
     void
     Task::paramActive(Parameter::Scope def_scope, Parameter::Visibility def_visibility, bool def_value)
     {
@@ -220,6 +345,16 @@ namespace DUNE
       .description(DTR("True to activate task, false otherwise"));
     }
 
+    void
+    Task::setDefaultCriticality(Criticality value)
+    {
+      static const char* c_names[] = {"High", "Normal", "Low"};
+
+      std::map<std::string, Parameter*>::iterator itr = m_params.find("Criticality");
+      if (itr != m_params.end())
+        itr->second->defaultValue(c_names[value]);
+    }
+
     void
     Task::updateParameters(bool act_deact)
     {
@@ -227,8 +362,7 @@ namespace DUNE
         m_entity->setLabel(m_args.elabel);
       if (m_args.elabel != m_entity->getLabel())
         m_params.set(DTR_RT("Entity Label"), m_entity->getLabel());
-      m_entity->setActTimes(m_args.act_time, m_args.deact_time);
-      m_entity->reportInfo();
+      reportActTimes();
 
       if (m_debug_level_string == "Debug")
         m_debug_level = DEBUG_LEVEL_DEBUG;
@@ -239,6 +373,13 @@ namespace DUNE
       else
         m_debug_level = DEBUG_LEVEL_NONE;
 
+      if (m_args.criticality == "High")
+        m_criticality = CRITICALITY_HIGH;
+      else if (m_args.criticality == "Low")
+        m_criticality = CRITICALITY_LOW;
+      else
+        m_criticality = CRITICALITY_NORMAL;
+
       onUpdateParameters();
 
       if (m_honours_active)
@@ -277,6 +418,7 @@ namespace DUNE
 
       if (m_entity->requestActivation())
       {
+        m_act_start = Time::Clock::get();
         spew("calling on request activation");
         onRequestActivation();
       }
@@ -297,6 +439,13 @@ namespace DUNE
       onActivation();
 
       m_entity->succeedActivation();
+
+      // Only timed activations are scheduled ahead by the plan engine.
+      if (m_act_start >= 0.0 && m_args.act_time > 0)
+        updateActivationStatistics(Time::Clock::get() - m_act_start);
+
+      m_act_start = -1.0;
+
       if (m_entity->hasPendingDeactivation())
         requestDeactivation();
     }
@@ -306,6 +455,7 @@ namespace DUNE
     {
       spew("activation failed: %s", reason.c_str());
       m_args.active = false;
+      m_act_start = -1.0;
       m_entity->failActivation(reason);
     }
 
@@ -365,18 +515,7 @@ namespace DUNE
       {
         try
         {
-          resolveEntities();
-          releaseResources();
-          acquireResources();
-          initializeResources();
-
-          if (m_honours_active)
-          {
-            Parameter::Scope active_scope = Parameter::scopeFromString(m_args.active_scope);
-            if (m_args.active && ((active_scope == Parameter::SCOPE_GLOBAL) || (active_scope == Parameter::SCOPE_IDLE)))
-              requestActivation();
-          }
-
+          bringUp(true, false);
           onMain();
           releaseResources();
         }
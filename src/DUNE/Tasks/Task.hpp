@@ -35,17 +35,21 @@
 #include <string>
 #include <map>
 #include <stack>
+#include <vector>
 #include <cstdarg>
 
 // DUNE headers.
 #include <DUNE/Config.hpp>
 #include <DUNE/Concurrency/Thread.hpp>
 #include <DUNE/Concurrency/TSQueue.hpp>
+#include <DUNE/Concurrency/Mutex.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
 #include <DUNE/Tasks/Recipient.hpp>
 #include <DUNE/Tasks/Consumer.hpp>
 #include <DUNE/IMC/Constants.hpp>
 #include <DUNE/IMC/Definitions.hpp>
 #include <DUNE/IMC/Factory.hpp>
+#include <DUNE/IMC/SourcePredicate.hpp>
 #include <DUNE/Status/Codes.hpp>
 #include <DUNE/Concurrency/TLS.hpp>
 #include <DUNE/Parsers/BasicStringReader.hpp>
@@ -106,6 +110,18 @@ namespace DUNE
       DF_LOOP_BACK = (1 << 2)
     };
 
+    //! Criticality class of a task, deciding which tasks may be
+    //! slowed down when the system is overloaded.
+    enum Criticality
+    {
+      //! Never throttled (control, navigation).
+      CRITICALITY_HIGH = 0,
+      //! Throttled only under sustained overload.
+      CRITICALITY_NORMAL = 1,
+      //! First to be throttled.
+      CRITICALITY_LOW = 2
+    };
+
     //! Task.
     class Task: public AbstractTask
     {
@@ -206,6 +222,14 @@ namespace DUNE
         return m_args.deact_time;
       }
 
+      //! Retrieve the activation time that is advertised to other
+      //! tasks. Once enough activations have been measured this is
+      //! derived from their statistics, bounded by the configured
+      //! activation time.
+      //! @return expected activation time of the task.
+      uint16_t
+      getExpectedActivationTime(void) const;
+
       //! Retrieve the identifier associated with a given system name.
       //! @param[in] name system name.
       //! @return system identifier.
@@ -245,6 +269,69 @@ namespace DUNE
         return m_args.priority;
       }
 
+      //! Get criticality class of the task.
+      //! @return criticality class.
+      Criticality
+      getCriticality(void) const
+      {
+        return m_criticality;
+      }
+
+      //! Set the fraction of its nominal workload the task should
+      //! perform. This is used by the task manager under overload.
+      //! @param[in] value throttle factor, between 0 and 1.
+      void
+      setThrottle(float value)
+      {
+        Concurrency::ScopedMutex l(m_load_lock);
+        m_throttle = value;
+      }
+
+      //! Get the fraction of its nominal workload the task should
+      //! perform.
+      //! @return throttle factor, 1 when not throttled.
+      float
+      getThrottle(void) const
+      {
+        Concurrency::ScopedMutex l(m_load_lock);
+        return m_throttle;
+      }
+
+      //! Check if the task is being throttled, in which case optional
+      //! work should be skipped.
+      //! @return true if task is throttled, false otherwise.
+      bool
+      isThrottled(void) const
+      {
+        return getThrottle() < 1.0f;
+      }
+
+      //! Check if the task can lower its workload when throttled.
+      //! @return true if the task can be throttled, false otherwise.
+      virtual bool
+      isThrottleable(void) const
+      {
+        return false;
+      }
+
+      //! Retrieve the number of execution deadlines missed so far.
+      //! @return deadline miss count.
+      unsigned
+      getDeadlineMisses(void) const
+      {
+        Concurrency::ScopedMutex l(m_load_lock);
+        return m_deadline_misses;
+      }
+
+      //! Retrieve the number of messages waiting to be consumed by
+      //! the task.
+      //! @return number of queued messages.
+      unsigned
+      getQueueSize(void)
+      {
+        return m_recipient->getQueueSize();
+      }
+
       //! Send an human-readable informational message to all
       //! configured output channels and files.
       //! @param format string format (similar to printf(3)).
@@ -371,6 +458,29 @@ namespace DUNE
       void
       writeParamsXML(std::ostream& os) const;
 
+      //! Bring the task up in the calling thread without starting
+      //! it, performing the same steps the task's thread performs
+      //! before entering onMain(). This is meant for offline
+      //! harnesses that drive a single task synchronously.
+      //! @param[in] force_activation request activation regardless
+      //! of the value of the 'Active' parameter.
+      void
+      setupInline(bool force_activation = false);
+
+      //! Drive the task from the calling thread by consuming all the
+      //! messages currently in the receiving queue. Derived classes
+      //! with a periodic body override this function to run it when
+      //! due. See setupInline().
+      //! @param[in] now harness time in seconds.
+      //! @return true if the task's periodic body ran, false otherwise.
+      virtual bool
+      stepInline(double now)
+      {
+        (void)now;
+        consumeMessages();
+        return false;
+      }
+
       //! Retrieve the main entity label of the task.
       //! @return main entity label.
       const char*
@@ -496,6 +606,17 @@ namespace DUNE
         m_recipient->waitForMessages(timeout);
       }
 
+      //! Wait for the receiving queue to contain at least one message
+      //! or for the task to be requested to stop, and then call the
+      //! consumer functions for all the messages currently in it.
+      //! Tasks with no work besides consuming messages should use
+      //! this function to avoid periodic wake-ups.
+      void
+      waitForMessages(void)
+      {
+        m_recipient->waitForMessages(-1.0);
+      }
+
       //! Call the consumers of all messages currently in the
       //! receiving queue.
       void
@@ -539,6 +660,20 @@ namespace DUNE
         return m_params.changed(&var);
       }
 
+      //! Change the default value of parameter 'Criticality'. This
+      //! function must be called in the constructor.
+      //! @param[in] value default criticality class.
+      void
+      setDefaultCriticality(Criticality value);
+
+      //! Record a missed execution deadline.
+      void
+      signalDeadlineMiss(void)
+      {
+        Concurrency::ScopedMutex l(m_load_lock);
+        ++m_deadline_misses;
+      }
+
       //! Declare parameter 'Active' and associated parameters 'Active
       //! - Scope' and 'Active - Visibility'. These parameters allows
       //! the task to be activated/deactivated using the message
@@ -570,6 +705,31 @@ namespace DUNE
         bind(M::getIdStatic(), new Consumer<T, M>(*task_obj, consumer));
       }
 
+      //! Bind a message to a consumer method, accepting only
+      //! messages from a given source. Messages from other sources
+      //! are discarded by the message bus before being queued.
+      //! @param task_obj consumer task.
+      //! @param source accepted sources.
+      //! @param consumer consumer method.
+      template <typename M, typename T>
+      void
+      bind(T* task_obj, const IMC::SourcePredicate& source,
+           void (T::* consumer)(const M*) = &T::consume)
+      {
+        bind(M::getIdStatic(), new Consumer<T, M>(*task_obj, consumer), source);
+      }
+
+      //! Change the accepted sources of all consumers of a bound
+      //! message. This is meant for sources that are only known
+      //! after entity resolution.
+      //! @param source accepted sources.
+      template <typename M>
+      void
+      setSource(const IMC::SourcePredicate& source)
+      {
+        m_recipient->setSource(M::getIdStatic(), source);
+      }
+
       //! Bind multiple messages to a default consumer method.
       //! @param task_obj consumer object.
       //! @param list list of message identifiers.
@@ -611,12 +771,14 @@ namespace DUNE
       //! Register a consumer for a given message identifier.
       //! @param[in] message_id message identifier.
       //! @param[in] consumer consumer object.
+      //! @param[in] source accepted sources.
       void
-      bind(unsigned int message_id, AbstractConsumer* consumer)
+      bind(unsigned int message_id, AbstractConsumer* consumer,
+           const IMC::SourcePredicate& source = IMC::SourcePredicate())
       {
         spew("registering consumer for '%s'",
              IMC::Factory::getAbbrevFromId(message_id).c_str());
-        m_recipient->bind(message_id, consumer);
+        m_recipient->bind(message_id, consumer, source);
       }
 
       //! Request task to start/resume normal execution.
@@ -777,8 +939,12 @@ namespace DUNE
         uint16_t act_time;
         //! Deactivation time.
         uint16_t deact_time;
+        //! Measured activation times (samples, mean and variance).
+        std::vector<double> act_stats;
         //! Scheduling priority.
         unsigned int priority;
+        //! Criticality class (as a string).
+        std::string criticality;
         //! True if task is active.
         bool active;
         //! Scope of 'Active' parameter.
@@ -799,8 +965,18 @@ namespace DUNE
       std::string m_debug_level_string;
       //! Debug level.
       DebugLevel m_debug_level;
+      //! Criticality class.
+      Criticality m_criticality;
+      //! Throttle factor.
+      float m_throttle;
+      //! Number of missed deadlines.
+      unsigned m_deadline_misses;
+      //! Lock for throttle factor and deadline misses.
+      mutable Concurrency::Mutex m_load_lock;
       //! Arguments.
       BasicArguments m_args;
+      //! Time at which the ongoing activation was requested.
+      double m_act_start;
       //! Parameters stack.
       std::stack<std::map<std::string, std::string> > m_params_stack;
       //! True if task honours changes to 'Active' parameter.
@@ -814,12 +990,41 @@ namespace DUNE
       void
       reportEntityState(void);
 
+      //! Update the main entity's activation and deactivation times
+      //! and report them.
+      void
+      reportActTimes(void);
+
+      //! Fold a measured activation time into the statistics and
+      //! persist them.
+      //! @param[in] duration activation time in seconds.
+      void
+      updateActivationStatistics(double duration);
+
       void
       log(IMC::LogBookEntry::TypeEnum type, const char* format, std::va_list arg_list);
 
+      //! Bring the task up: resolve entities, (re)acquire and
+      //! initialize resources and request the initial activation.
+      //! @param[in] retry retry resource initialization until it
+      //! succeeds or the task is stopped.
+      //! @param[in] force_activation request activation regardless
+      //! of the value of the 'Active' parameter.
+      void
+      bringUp(bool retry, bool force_activation);
+
       void
       run(void);
 
+      //! Request the task's thread to stop and wake it up if it is
+      //! waiting for messages.
+      void
+      stopImpl(void)
+      {
+        Concurrency::Thread::stopImpl();
+        m_recipient->interrupt();
+      }
+
       //! Consume QueryEntityState messages and reply accordingly.
       //! @param[in] msg QueryEntityState message.
       void
@@ -0,0 +1,114 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <set>
+#include <cmath>
+
+// DUNE headers.
+#include <DUNE/Time/Clock.hpp>
+#include <DUNE/Time/TimerWheel.hpp>
+#include <DUNE/Concurrency/ScopedMutex.hpp>
+
+namespace DUNE
+{
+  namespace Time
+  {
+    //! Default slot width (s).
+    static const double c_granularity = 0.01;
+    //! Maximum number of registered wake-ups.
+    static const unsigned c_max_pending = 1024;
+
+    //! Registered wake-ups.
+    static std::set<double> s_pending;
+    //! Slot width (s).
+    static double s_granularity = c_granularity;
+    //! Lock for the registry.
+    static Concurrency::Mutex s_lock;
+
+    double
+    TimerWheel::schedule(double deadline, double slack)
+    {
+      Concurrency::ScopedMutex l(s_lock);
+
+      // Forget wake-ups that already happened.
+      double now = Clock::get();
+      while (!s_pending.empty() && (*s_pending.begin() < now || s_pending.size() > c_max_pending))
+        s_pending.erase(s_pending.begin());
+
+      if (slack < 0)
+        slack = 0;
+
+      double wake = deadline;
+      std::set<double>::iterator itr = s_pending.lower_bound(deadline);
+      if (itr != s_pending.end() && *itr <= deadline + slack)
+      {
+        wake = *itr;
+      }
+      else if (slack > 0)
+      {
+        double slot = std::ceil(deadline / s_granularity) * s_granularity;
+        if (slot > deadline && slot <= deadline + slack)
+          wake = slot;
+      }
+
+      s_pending.insert(wake);
+      return wake;
+    }
+
+    void
+    TimerWheel::setGranularity(double value)
+    {
+      Concurrency::ScopedMutex l(s_lock);
+      if (value > 0)
+        s_granularity = value;
+    }
+
+    double
+    TimerWheel::getGranularity(void)
+    {
+      Concurrency::ScopedMutex l(s_lock);
+      return s_granularity;
+    }
+
+    unsigned
+    TimerWheel::getPending(void)
+    {
+      Concurrency::ScopedMutex l(s_lock);
+      return s_pending.size();
+    }
+
+    void
+    TimerWheel::clear(void)
+    {
+      Concurrency::ScopedMutex l(s_lock);
+      s_pending.clear();
+    }
+  }
+}
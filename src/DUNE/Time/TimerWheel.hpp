@@ -0,0 +1,86 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef DUNE_TIME_TIMER_WHEEL_HPP_INCLUDED_
+#define DUNE_TIME_TIMER_WHEEL_HPP_INCLUDED_
+
+// DUNE headers.
+#include <DUNE/Config.hpp>
+
+namespace DUNE
+{
+  namespace Time
+  {
+    // Export DLL Symbol.
+    class DUNE_DLL_SYM TimerWheel;
+
+    //! Process-wide registry of upcoming wake-up instants. Periodic
+    //! activities that tolerate some lateness schedule their
+    //! wake-ups through it, so that deadlines of unrelated threads
+    //! falling within each other's slack are merged into a single
+    //! wake-up. A deadline without slack is never moved. Periodic
+    //! tasks without slack do not schedule through the wheel at
+    //! all, so only tasks configured with slack share wake-ups.
+    class TimerWheel
+    {
+    public:
+      //! Schedule a wake-up. If another wake-up is already scheduled
+      //! in the interval [deadline, deadline + slack] it is reused,
+      //! otherwise the deadline is aligned to the first slot boundary
+      //! within that interval.
+      //! @param[in] deadline nominal wake-up instant (monotonic clock,
+      //! in seconds, see Clock::get()).
+      //! @param[in] slack tolerated lateness in seconds.
+      //! @return wake-up instant.
+      static double
+      schedule(double deadline, double slack);
+
+      //! Set the width of the wheel's slots.
+      //! @param[in] value slot width in seconds.
+      static void
+      setGranularity(double value);
+
+      //! Get the width of the wheel's slots.
+      //! @return slot width in seconds.
+      static double
+      getGranularity(void);
+
+      //! Get the number of wake-ups currently registered.
+      //! @return number of registered wake-ups.
+      static unsigned
+      getPending(void);
+
+      //! Forget all registered wake-ups.
+      static void
+      clear(void);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,555 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+#include <new>
+#include <map>
+#include <set>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_TIME_H)
+#  include <time.h>
+#endif
+
+void
+registerStaticTasks(void);
+
+using DUNE_NAMESPACES;
+
+//! True while allocations are being accounted.
+static bool s_counting = false;
+//! Number of allocations while accounting.
+static uint64_t s_alloc_count = 0;
+//! Number of bytes allocated while accounting.
+static uint64_t s_alloc_bytes = 0;
+
+void*
+operator new(std::size_t size)
+{
+  if (s_counting)
+  {
+    ++s_alloc_count;
+    s_alloc_bytes += size;
+  }
+
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == NULL)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void*
+operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void
+operator delete(void* ptr) throw()
+{
+  std::free(ptr);
+}
+
+void
+operator delete[](void* ptr) throw()
+{
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) throw()
+{
+  std::free(ptr);
+}
+
+void
+operator delete[](void* ptr, std::size_t) throw()
+{
+  std::free(ptr);
+}
+
+//! CPU time consumed by the calling thread in nanoseconds.
+static uint64_t
+getThreadTime(void)
+{
+#if defined(DUNE_SYS_HAS_CLOCK_GETTIME) && defined(CLOCK_THREAD_CPUTIME_ID)
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return (uint64_t)ts.tv_sec * Time::c_nsec_per_sec + (uint64_t)ts.tv_nsec;
+#else
+  return Clock::getNsecRT();
+#endif
+}
+
+//! Accumulated cost of consuming one kind of message.
+struct Cost
+{
+  //! Number of samples.
+  uint64_t count;
+  //! Total CPU time (ns).
+  uint64_t cpu_total;
+  //! Largest CPU time of a single sample (ns).
+  uint64_t cpu_max;
+  //! Total number of allocations.
+  uint64_t allocs;
+  //! Total number of allocated bytes.
+  uint64_t bytes;
+
+  Cost(void):
+    count(0),
+    cpu_total(0),
+    cpu_max(0),
+    allocs(0),
+    bytes(0)
+  { }
+
+  void
+  add(uint64_t cpu, uint64_t alloc_count, uint64_t alloc_bytes)
+  {
+    ++count;
+    cpu_total += cpu;
+    if (cpu > cpu_max)
+      cpu_max = cpu;
+    allocs += alloc_count;
+    bytes += alloc_bytes;
+  }
+};
+
+//! Bus recipient that collects everything dispatched by the task
+//! under test.
+class Capture: public Tasks::AbstractTask
+{
+public:
+  Capture(Tasks::Context& ctx, std::ostream* os):
+    m_ctx(ctx),
+    m_os(os),
+    m_total(0)
+  {
+    std::vector<uint32_t> ids;
+    IMC::Factory::getIds(ids);
+    for (unsigned i = 0; i < ids.size(); ++i)
+      m_ctx.mbus.registerRecipient(this, ids[i]);
+  }
+
+  ~Capture(void)
+  {
+    std::vector<uint32_t> ids;
+    IMC::Factory::getIds(ids);
+    for (unsigned i = 0; i < ids.size(); ++i)
+      m_ctx.mbus.unregisterRecipient(this, ids[i]);
+  }
+
+  void
+  receive(const IMC::Message* msg)
+  {
+    ++m_counts[msg->getName()];
+    ++m_total;
+
+    if (m_os != NULL)
+    {
+      bool counting = s_counting;
+      s_counting = false;
+      IMC::Packet::serialize(msg, *m_os);
+      s_counting = counting;
+    }
+  }
+
+  const std::map<std::string, uint64_t>&
+  getCounts(void) const
+  {
+    return m_counts;
+  }
+
+  uint64_t
+  getTotal(void) const
+  {
+    return m_total;
+  }
+
+  const char*
+  getName(void) const
+  {
+    return "Bench";
+  }
+
+  void
+  inf(const char*, ...)
+  { }
+
+  void
+  war(const char*, ...)
+  { }
+
+  void
+  err(const char*, ...)
+  { }
+
+  void
+  cri(const char*, ...)
+  { }
+
+  void
+  debug(const char*, ...)
+  { }
+
+  void
+  trace(const char*, ...)
+  { }
+
+  void
+  spew(const char*, ...)
+  { }
+
+private:
+  //! Context.
+  Tasks::Context& m_ctx;
+  //! Output stream for captured messages.
+  std::ostream* m_os;
+  //! Number of captured messages by name.
+  std::map<std::string, uint64_t> m_counts;
+  //! Total number of captured messages.
+  uint64_t m_total;
+
+  void
+  run(void)
+  { }
+};
+
+//! Open a log file, transparently handling compressed files and
+//! log folders.
+static std::istream*
+openLog(const std::string& name)
+{
+  Path file(name);
+
+  if (file.isDirectory())
+  {
+    file = file / "Data.lsf";
+    if (!file.isFile())
+      file += ".gz";
+  }
+
+  if (!file.isFile())
+    throw std::runtime_error(String::str("%s does not exist", file.c_str()));
+
+  Compression::Methods method = Compression::Factory::detect(file.c_str());
+  if (method == METHOD_UNKNOWN)
+    return new std::ifstream(file.c_str(), std::ios::binary);
+
+  return new Compression::FileInput(file.c_str(), method);
+}
+
+//! Reproduce the entity identifiers of the logged system, so that
+//! entity resolution performed by the task under test yields the
+//! same identifiers found in the log. Entities owned by the task
+//! under test are replaced by placeholders and reserved again by the
+//! task itself.
+//! @return source system of the log.
+static unsigned
+loadEntities(Tasks::Context& ctx, const std::string& log, const std::string& section)
+{
+  std::istream* is = openLog(log);
+  std::map<unsigned, IMC::EntityInfo> infos;
+  unsigned system = IMC::AddressResolver::invalid();
+  IMC::Message* msg = NULL;
+
+  while ((msg = IMC::Packet::deserialize(*is)) != NULL)
+  {
+    if (msg->getId() == DUNE_IMC_ENTITYINFO)
+    {
+      if (system == IMC::AddressResolver::invalid())
+        system = msg->getSource();
+
+      if (msg->getSource() == system)
+      {
+        const IMC::EntityInfo* info = static_cast<const IMC::EntityInfo*>(msg);
+        infos[info->id] = *info;
+      }
+    }
+
+    delete msg;
+  }
+
+  delete is;
+
+  if (infos.empty())
+    return system;
+
+  unsigned last = infos.rbegin()->first;
+  for (unsigned id = 0; id <= last; ++id)
+  {
+    std::map<unsigned, IMC::EntityInfo>::const_iterator itr = infos.find(id);
+    if (itr == infos.end() || itr->second.component == section)
+      ctx.entities.reserve(String::str("Bench Placeholder %u", id), "Bench");
+    else
+      ctx.entities.reserve(itr->second.label, itr->second.component);
+  }
+
+  return system;
+}
+
+static void
+report(const std::map<std::string, Cost>& costs, const Cost& timer, const Capture& capture, double wall)
+{
+  std::fprintf(stdout, "%-28s %10s %12s %10s %10s %10s %12s\n",
+               "Message", "Count", "Total (ms)", "Mean (us)",
+               "Max (us)", "Allocs", "Bytes");
+
+  uint64_t count = 0;
+  uint64_t cpu = 0;
+  std::map<std::string, Cost>::const_iterator itr = costs.begin();
+  for (; itr != costs.end(); ++itr)
+  {
+    const Cost& c = itr->second;
+    count += c.count;
+    cpu += c.cpu_total;
+
+    std::fprintf(stdout, "%-28s %10llu %12.3f %10.3f %10.3f %10.2f %12.1f\n",
+                 itr->first.c_str(),
+                 (unsigned long long)c.count,
+                 c.cpu_total / 1e6,
+                 (c.cpu_total / 1e3) / c.count,
+                 c.cpu_max / 1e3,
+                 (double)c.allocs / c.count,
+                 (double)c.bytes / c.count);
+  }
+
+  std::fprintf(stdout, "\nSteps: %llu, CPU: %0.3f ms, wall: %0.3f s (%0.1f steps/s)\n",
+               (unsigned long long)count, cpu / 1e6, wall, count / wall);
+
+  if (timer.count > 0)
+  {
+    std::fprintf(stdout, "Timer-driven executions: %llu, CPU: %0.3f ms (mean %0.3f us, max %0.3f us)\n",
+                 (unsigned long long)timer.count, timer.cpu_total / 1e6,
+                 (timer.cpu_total / 1e3) / timer.count, timer.cpu_max / 1e3);
+  }
+
+  std::fprintf(stdout, "\nCaptured outputs: %llu\n",
+               (unsigned long long)capture.getTotal());
+
+  std::map<std::string, uint64_t>::const_iterator citr = capture.getCounts().begin();
+  for (; citr != capture.getCounts().end(); ++citr)
+    std::fprintf(stdout, "  %-26s %10llu\n", citr->first.c_str(), (unsigned long long)citr->second);
+}
+
+int
+main(int argc, char** argv)
+{
+  Tasks::Context context;
+  I18N::setLanguage(context.dir_i18n);
+
+  OptionParser options;
+  options.executable("dune-bench")
+  .program(DUNE_SHORT_NAME)
+  .copyright(DUNE_COPYRIGHT)
+  .email(DUNE_CONTACT)
+  .version(getFullVersion())
+  .date(getCompileDate())
+  .arch(DUNE_SYSTEM_NAME)
+  .description("Drive a single task with the messages of a LSF log, as fast as "
+               "it can consume them, and report the cost of each message.")
+  .add("-d", "--config-dir",
+       "Configuration directory", "DIR")
+  .add("-c", "--config-file",
+       "Load configuration file CONFIG", "CONFIG")
+  .add("-t", "--task",
+       "Configuration section of the task under test", "SECTION")
+  .add("-l", "--log",
+       "LSF file or log folder to replay", "LOG")
+  .add("-m", "--messages",
+       "Only replay messages in comma separated LIST", "LIST")
+  .add("-o", "--output",
+       "Write messages dispatched by the task to LSF file FILE", "FILE")
+  .add("-A", "--activate",
+       "Activate the task regardless of its 'Active' parameter");
+
+  if (!options.parse(argc, argv))
+  {
+    if (options.bad())
+      std::cerr << "ERROR: " << options.error() << std::endl;
+    options.usage();
+    return 1;
+  }
+
+  if (options.value("--config-file").empty()
+      || options.value("--task").empty()
+      || options.value("--log").empty())
+  {
+    std::cerr << "ERROR: options --config-file, --task and --log are mandatory" << std::endl;
+    options.usage();
+    return 1;
+  }
+
+  if (!options.value("--config-dir").empty())
+    context.dir_cfg = options.value("--config-dir");
+
+  registerStaticTasks();
+
+  std::string section = options.value("--task");
+  std::string task_name = Tasks::Manager::getTaskName(section);
+  std::string log = options.value("--log");
+
+  if (!Tasks::Factory::exists(task_name))
+  {
+    std::cerr << "ERROR: unknown task '" << task_name << "'" << std::endl;
+    return 1;
+  }
+
+  Path cfg_file = context.dir_cfg / options.value("--config-file") + ".ini";
+  try
+  {
+    context.config.parseFile(cfg_file.c_str());
+    context.original_cfg.parseFile(cfg_file.c_str());
+  }
+  catch (std::runtime_error& e)
+  {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+
+  std::set<uint32_t> filter;
+  if (!options.value("--messages").empty())
+  {
+    std::vector<uint32_t> ids;
+    IMC::Factory::getIds(options.value("--messages"), ids);
+    filter.insert(ids.begin(), ids.end());
+  }
+
+  std::ofstream* ofs = NULL;
+  if (!options.value("--output").empty())
+  {
+    ofs = new std::ofstream(options.value("--output").c_str(), std::ios::binary);
+    if (!ofs->is_open())
+    {
+      std::cerr << "ERROR: failed to create file '" << options.value("--output") << "'" << std::endl;
+      delete ofs;
+      return 1;
+    }
+  }
+
+  std::map<std::string, Cost> costs;
+  Cost timer;
+  Capture* capture = NULL;
+  Tasks::Task* task = NULL;
+  std::istream* is = NULL;
+  int rv = 0;
+
+  try
+  {
+    unsigned system = loadEntities(context, log, section);
+    if (system == IMC::AddressResolver::invalid())
+    {
+      std::string sys_name;
+      context.config.get("General", "Vehicle", "unknown", sys_name);
+      context.resolver.name(sys_name);
+    }
+    else
+    {
+      context.resolver.name(String::str("bench-%u", system));
+      context.resolver.id(system);
+    }
+
+    capture = new Capture(context, ofs);
+    task = Tasks::Factory::produce(task_name, section, context);
+    if (task == NULL)
+      throw std::runtime_error("failed to create task");
+
+    task->loadConfig();
+    task->reserveEntities();
+    task->setupInline(!options.value("--activate").empty());
+    task->stepInline(0.0);
+
+    // Only messages consumed by the task are fed to it.
+    std::set<uint32_t> bound;
+    std::vector<IMC::TransportBindings*> bindings = context.mbus.getBindings();
+    for (unsigned i = 0; i < bindings.size(); ++i)
+    {
+      if (bindings[i]->consumer == task->getName())
+        bound.insert(bindings[i]->message_id);
+    }
+
+    is = openLog(log);
+    IMC::Message* msg = IMC::Packet::deserialize(*is);
+    double origin = (msg == NULL) ? 0.0 : msg->getTimeStamp();
+    double start = Clock::getRT();
+
+    for (; msg != NULL; msg = IMC::Packet::deserialize(*is))
+    {
+      bool fed = (bound.find(msg->getId()) != bound.end())
+      && (filter.empty() || (filter.find(msg->getId()) != filter.end()));
+
+      s_alloc_count = 0;
+      s_alloc_bytes = 0;
+      uint64_t cpu = getThreadTime();
+      s_counting = true;
+
+      if (fed)
+        context.mbus.dispatch(msg, capture);
+
+      bool ran = task->stepInline(msg->getTimeStamp() - origin);
+
+      s_counting = false;
+      cpu = getThreadTime() - cpu;
+
+      // Messages not fed to the task only advance the harness time,
+      // their cost is booked apart if the periodic body ran.
+      if (fed)
+        costs[msg->getName()].add(cpu, s_alloc_count, s_alloc_bytes);
+      else if (ran)
+        timer.add(cpu, s_alloc_count, s_alloc_bytes);
+
+      delete msg;
+    }
+
+    report(costs, timer, *capture, Clock::getRT() - start);
+    task->releaseResources();
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    rv = 1;
+  }
+
+  delete is;
+  delete task;
+  delete capture;
+  delete ofs;
+
+  return rv;
+}
@@ -0,0 +1,286 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_SIGNAL_H)
+#  include <signal.h>
+#endif
+
+// Microsoft Windows headers.
+#if defined(DUNE_SYS_HAS_WINDOWS_H)
+#  include <windows.h>
+#endif
+
+void
+registerStaticTasks(void);
+
+using DUNE_NAMESPACES;
+
+static bool s_stop = false;
+
+// POSIX implementation.
+#if defined(DUNE_OS_POSIX)
+extern "C" void
+handleTerminate(int signo)
+{
+  switch (signo)
+  {
+    case SIGINT:
+    case SIGTERM:
+      s_stop = true;
+      break;
+  }
+}
+
+// Microsoft Windows implementation.
+#elif defined(DUNE_OS_WINDOWS)
+BOOL
+handleTerminate(DWORD type)
+{
+  switch (type)
+  {
+    case CTRL_C_EVENT:
+    case CTRL_CLOSE_EVENT:
+    case WM_CLOSE:
+      s_stop = true;
+      return TRUE;
+    default:
+      return FALSE;
+  }
+}
+
+#endif
+
+static void
+setFleetSignalHandlers(void)
+{
+#if defined(DUNE_SYS_HAS_SIGACTION)
+  struct sigaction actions;
+
+  std::memset(&actions, 0, sizeof(actions));
+  sigemptyset(&actions.sa_mask);
+  actions.sa_flags = 0;
+  actions.sa_handler = handleTerminate;
+
+  sigaction(SIGINT, &actions, 0);
+  sigaction(SIGTERM, &actions, 0);
+  sigaction(SIGPIPE, &actions, 0);
+
+#elif defined(DUNE_OS_WINDOWS)
+  SetConsoleCtrlHandler((PHANDLER_ROUTINE)handleTerminate, TRUE);
+
+#endif
+}
+
+//! Load a configuration file into a context.
+//! @param[in] ctx context.
+//! @param[in] name configuration name.
+//! @return true on success, false otherwise.
+static bool
+loadConfig(Tasks::Context& ctx, const std::string& name)
+{
+  Path cfg_file = ctx.dir_cfg / name + ".ini";
+  try
+  {
+    ctx.config.parseFile(cfg_file.c_str());
+    ctx.original_cfg.parseFile(cfg_file.c_str());
+  }
+  catch (std::runtime_error& e)
+  {
+    try
+    {
+      cfg_file = ctx.dir_usr_cfg / name + ".ini";
+      ctx.config.parseFile(cfg_file.c_str());
+      ctx.original_cfg.parseFile(cfg_file.c_str());
+      ctx.dir_cfg = ctx.dir_usr_cfg;
+    }
+    catch (std::runtime_error& e2)
+    {
+      std::cerr << String::str("ERROR: %s\n", e.what()) << std::endl;
+      std::cerr << String::str("ERROR: %s\n", e2.what()) << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int
+main(int argc, char** argv)
+{
+  OptionParser options;
+  options.executable("dune-fleet")
+  .program(DUNE_SHORT_NAME " Fleet")
+  .copyright(DUNE_COPYRIGHT)
+  .email(DUNE_CONTACT)
+  .version(getFullVersion())
+  .date(getCompileDate())
+  .arch(DUNE_SYSTEM_NAME)
+  .description("Run several vehicles inside a single process. Vehicles "
+               "exchange messages through the Transports.Fleet task.")
+  .add("-d", "--config-dir",
+       "Configuration directory", "DIR")
+  .add("-c", "--config-files",
+       "Comma separated list of configuration files", "CONFIGS")
+  .add("-V", "--vehicles",
+       "Comma separated list of vehicle names", "VEHICLES")
+  .add("-p", "--profiles",
+       "Execution Profiles", "PROFILES")
+  .add("-s", "--speed",
+       "Time multiplier", "SPEED");
+
+  // Parse command line arguments.
+  if (!options.parse(argc, argv))
+  {
+    if (options.bad())
+      std::cerr << "ERROR: " << options.error() << std::endl;
+    options.usage();
+    return 1;
+  }
+
+  std::vector<std::string> configs;
+  String::split(options.value("--config-files"), ",", configs);
+  std::vector<std::string> vehicles;
+  String::split(options.value("--vehicles"), ",", vehicles);
+
+  if (configs.empty() || configs[0].empty())
+  {
+    std::cerr << "ERROR: no configuration file was given" << std::endl;
+    options.usage();
+    return 1;
+  }
+
+  if (!vehicles.empty() && vehicles[0].empty())
+    vehicles.clear();
+
+  // One configuration shared by all vehicles or one per vehicle.
+  size_t count = vehicles.empty() ? configs.size() : vehicles.size();
+  if (configs.size() != 1 && configs.size() != count)
+  {
+    std::cerr << "ERROR: number of configurations does not match "
+              << "the number of vehicles" << std::endl;
+    return 1;
+  }
+
+  if (options.value("--speed") != "")
+  {
+    double speed = 1.0;
+    if (!castLexical(options.value("--speed"), speed) || speed <= 0)
+    {
+      std::cerr << "ERROR: invalid time multiplier" << std::endl;
+      return 1;
+    }
+
+    Time::Clock::setTimeMultiplier(speed);
+  }
+
+  std::vector<Tasks::Context*> contexts;
+  std::vector<DUNE::Daemon*> daemons;
+  int rv = 0;
+
+  try
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      Tasks::Context* ctx = new Tasks::Context;
+      contexts.push_back(ctx);
+
+      if (i == 0)
+      {
+        I18N::setLanguage(ctx->dir_i18n);
+        DUNE::Tasks::Factory::registerDynamicTasks(ctx->dir_lib.c_str());
+        registerStaticTasks();
+      }
+
+      if (options.value("--config-dir") != "")
+        ctx->dir_cfg = options.value("--config-dir");
+
+      const std::string& cfg = configs.size() == 1 ? configs[0] : configs[i];
+      if (!loadConfig(*ctx, cfg))
+        throw std::runtime_error(String::str("failed to load '%s'", cfg.c_str()));
+
+      if (!vehicles.empty())
+        ctx->config.set("General", "Vehicle", vehicles[i]);
+
+      daemons.push_back(new DUNE::Daemon(*ctx, options.value("--profiles")));
+    }
+
+    setFleetSignalHandlers();
+
+    for (size_t i = 0; i < daemons.size(); ++i)
+      daemons[i]->start();
+
+    while (!s_stop)
+    {
+      bool running = true;
+      for (size_t i = 0; i < daemons.size(); ++i)
+        running = running && daemons[i]->isRunning();
+
+      if (!running)
+      {
+        rv = 1;
+        break;
+      }
+
+      Delay::wait(1.0);
+    }
+
+    DUNE_WRN("Fleet", DTR("stopping vehicles"));
+
+    for (size_t i = 0; i < daemons.size(); ++i)
+      daemons[i]->stop();
+
+    for (size_t i = 0; i < daemons.size(); ++i)
+      daemons[i]->join();
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    rv = 1;
+  }
+
+  for (size_t i = 0; i < daemons.size(); ++i)
+    delete daemons[i];
+
+  for (size_t i = 0; i < contexts.size(); ++i)
+    delete contexts[i];
+
+  return rv;
+}
@@ -0,0 +1,736 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// POSIX headers.
+#if defined(DUNE_SYS_HAS_SIGNAL_H)
+#  include <signal.h>
+#endif
+
+void
+registerStaticTasks(void);
+
+using DUNE_NAMESPACES;
+
+//! Identifier of the plan executed repeatedly.
+static const char* c_plan_id = "soak";
+//! Maximum simulated duration of a plan before it is retried.
+static const double c_plan_timeout = 3600.0;
+//! Simulated time to wait before retrying a failed plan.
+static const double c_plan_backoff = 30.0;
+
+static bool s_stop = false;
+
+#if defined(DUNE_OS_POSIX)
+extern "C" void
+handleTerminate(int signo)
+{
+  switch (signo)
+  {
+    case SIGINT:
+    case SIGTERM:
+      s_stop = true;
+      break;
+  }
+}
+#endif
+
+static void
+setSoakSignalHandlers(void)
+{
+#if defined(DUNE_SYS_HAS_SIGACTION)
+  struct sigaction actions;
+
+  std::memset(&actions, 0, sizeof(actions));
+  sigemptyset(&actions.sa_mask);
+  actions.sa_flags = 0;
+  actions.sa_handler = handleTerminate;
+
+  sigaction(SIGINT, &actions, 0);
+  sigaction(SIGTERM, &actions, 0);
+  sigaction(SIGPIPE, &actions, 0);
+#endif
+}
+
+//! Task running inside the vehicle under test. It measures how long
+//! messages wait in its queue before being consumed and keeps the
+//! vehicle busy executing a square plan around its initial position.
+class Probe: public Tasks::Task
+{
+public:
+  Probe(Tasks::Context& ctx, double plan_size, double plan_depth, double plan_speed):
+    Tasks::Task("Soak", ctx),
+    m_plan_size(plan_size),
+    m_plan_depth(plan_depth),
+    m_plan_speed(plan_speed),
+    m_lat(0),
+    m_lon(0),
+    m_home_lat(0),
+    m_home_lon(0),
+    m_home_valid(false),
+    m_service(false),
+    m_req(0),
+    m_waiting(false),
+    m_executing(false),
+    m_request_time(0),
+    m_retry_time(0),
+    m_started(0),
+    m_succeeded(0),
+    m_failed(0)
+  {
+    bind<IMC::EstimatedState>(this);
+    bind<IMC::PlanControl>(this);
+    bind<IMC::PlanControlState>(this);
+    bind<IMC::VehicleState>(this);
+  }
+
+  void
+  consume(const IMC::EstimatedState* msg)
+  {
+    record(msg);
+    Coordinates::toWGS84(*msg, m_lat, m_lon);
+  }
+
+  void
+  consume(const IMC::PlanControl* msg)
+  {
+    if (msg->type != IMC::PlanControl::PC_FAILURE || msg->request_id != m_req)
+      return;
+
+    if (m_waiting)
+    {
+      war("plan failed: %s", msg->info.c_str());
+      finish(false);
+    }
+  }
+
+  void
+  consume(const IMC::VehicleState* msg)
+  {
+    record(msg);
+    m_service = (msg->op_mode == IMC::VehicleState::VS_SERVICE);
+  }
+
+  void
+  consume(const IMC::PlanControlState* msg)
+  {
+    record(msg);
+
+    double now = Clock::get();
+
+    if (m_waiting)
+    {
+      if (msg->plan_id == c_plan_id && (msg->state == IMC::PlanControlState::PCS_INITIALIZING
+                                        || msg->state == IMC::PlanControlState::PCS_EXECUTING))
+        m_executing = true;
+
+      if (m_executing && msg->state == IMC::PlanControlState::PCS_READY)
+        finish(msg->last_outcome == IMC::PlanControlState::LPO_SUCCESS);
+      else if (now - m_request_time > c_plan_timeout)
+        finish(false);
+
+      return;
+    }
+
+    if (m_service && msg->state == IMC::PlanControlState::PCS_READY && now >= m_retry_time)
+      startPlan(now);
+  }
+
+  //! Retrieve and clear the queueing delays measured so far.
+  //! @param[out] delays delays in seconds of real time.
+  void
+  takeLatencies(std::vector<double>& delays)
+  {
+    Concurrency::ScopedMutex l(m_mutex);
+    delays.clear();
+    delays.swap(m_delays);
+  }
+
+  unsigned
+  getStarted(void) const
+  {
+    return m_started;
+  }
+
+  unsigned
+  getSucceeded(void) const
+  {
+    return m_succeeded;
+  }
+
+  unsigned
+  getFailed(void) const
+  {
+    return m_failed;
+  }
+
+private:
+  //! Length of the side of the square plan.
+  double m_plan_size;
+  //! Depth of the plan.
+  double m_plan_depth;
+  //! Speed of the plan.
+  double m_plan_speed;
+  //! Current position.
+  double m_lat;
+  double m_lon;
+  //! Position when the first plan was started.
+  double m_home_lat;
+  double m_home_lon;
+  bool m_home_valid;
+  //! True if the vehicle is ready to execute plans.
+  bool m_service;
+  //! Last request identifier.
+  uint16_t m_req;
+  //! True while a plan is in progress.
+  bool m_waiting;
+  //! True once the plan in progress was seen executing.
+  bool m_executing;
+  //! Time of the last request.
+  double m_request_time;
+  //! Time before which no plan is started.
+  double m_retry_time;
+  //! Plan counters.
+  unsigned m_started;
+  unsigned m_succeeded;
+  unsigned m_failed;
+  //! Queueing delays.
+  std::vector<double> m_delays;
+  //! Mutex protecting the delays.
+  Concurrency::Mutex m_mutex;
+
+  //! Record the delay between dispatch and consumption of a message.
+  //! @param[in] msg message.
+  void
+  record(const IMC::Message* msg)
+  {
+    double delay = (Clock::getSinceEpoch() - msg->getTimeStamp()) / Clock::getTimeMultiplier();
+
+    Concurrency::ScopedMutex l(m_mutex);
+    m_delays.push_back(std::max(0.0, delay));
+  }
+
+  //! Account the end of the plan in progress.
+  //! @param[in] success true if the plan was successful.
+  void
+  finish(bool success)
+  {
+    if (success)
+    {
+      ++m_succeeded;
+    }
+    else
+    {
+      ++m_failed;
+      m_retry_time = Clock::get() + c_plan_backoff;
+    }
+
+    m_waiting = false;
+    m_executing = false;
+  }
+
+  //! Add a goto maneuver to a plan.
+  //! @param[in] north northing offset from the initial position.
+  //! @param[in] east easting offset from the initial position.
+  //! @param[out] spec plan specification.
+  void
+  addGoto(double north, double east, IMC::PlanSpecification& spec)
+  {
+    IMC::Goto man;
+    man.timeout = 1000;
+    man.lat = m_home_lat;
+    man.lon = m_home_lon;
+    WGS84::displace(north, east, &man.lat, &man.lon);
+    man.z = m_plan_depth;
+    man.z_units = IMC::Z_DEPTH;
+    man.speed = m_plan_speed;
+    man.speed_units = IMC::SUNITS_METERS_PS;
+
+    IMC::PlanManeuver pman;
+    pman.maneuver_id = String::str(spec.maneuvers.size() + 1);
+    pman.data.set(man);
+
+    if (!spec.maneuvers.empty())
+    {
+      IMC::PlanTransition trans;
+      trans.conditions = "ManeuverIsDone";
+      trans.source_man = String::str(spec.maneuvers.size());
+      trans.dest_man = pman.maneuver_id;
+      spec.transitions.push_back(trans);
+    }
+
+    spec.maneuvers.push_back(pman);
+  }
+
+  //! Request the execution of the square plan.
+  //! @param[in] now current time.
+  void
+  startPlan(double now)
+  {
+    if (!m_home_valid)
+    {
+      m_home_lat = m_lat;
+      m_home_lon = m_lon;
+      m_home_valid = true;
+    }
+
+    IMC::PlanSpecification spec;
+    spec.plan_id = c_plan_id;
+    spec.start_man_id = "1";
+    addGoto(m_plan_size, 0, spec);
+    addGoto(m_plan_size, m_plan_size, spec);
+    addGoto(0, m_plan_size, spec);
+    addGoto(0, 0, spec);
+
+    IMC::PlanControl pc;
+    pc.type = IMC::PlanControl::PC_REQUEST;
+    pc.op = IMC::PlanControl::PC_START;
+    pc.request_id = ++m_req;
+    pc.plan_id = c_plan_id;
+    pc.arg.set(spec);
+    pc.setDestination(getSystemId());
+    dispatch(pc);
+
+    m_waiting = true;
+    m_executing = false;
+    m_request_time = now;
+    ++m_started;
+  }
+
+  void
+  onMain(void)
+  {
+    while (!stopping())
+      waitForMessages();
+  }
+};
+
+//! Samples of one resource metric.
+struct Series
+{
+  //! Metric name.
+  std::string name;
+  //! Unit.
+  std::string unit;
+  //! Growth below this value is never considered drift.
+  double floor;
+  //! Sampling times (seconds of simulated time).
+  std::vector<double> times;
+  //! Sampled values.
+  std::vector<double> values;
+
+  Series(const std::string& n, const std::string& u, double f):
+    name(n),
+    unit(u),
+    floor(f)
+  { }
+
+  void
+  add(double time, double value)
+  {
+    if (value < 0)
+      return;
+
+    times.push_back(time);
+    values.push_back(value);
+  }
+};
+
+//! Read a numeric field of /proc/self/status.
+//! @param[in] field field name.
+//! @return field value or -1 if not available.
+static double
+readStatus(const std::string& field)
+{
+  std::ifstream ifs("/proc/self/status");
+  std::string line;
+
+  while (std::getline(ifs, line))
+  {
+    if (line.compare(0, field.size() + 1, field + ":") != 0)
+      continue;
+
+    return std::atof(line.c_str() + field.size() + 1);
+  }
+
+  return -1;
+}
+
+//! Count the open file descriptors of this process.
+//! @return number of file descriptors or -1 if not available.
+static double
+countDescriptors(void)
+{
+  FileSystem::Directory dir;
+  if (!dir.open("/proc/self/fd"))
+    return -1;
+
+  double count = 0;
+  while (dir.readEntry() != NULL)
+    ++count;
+
+  // Exclude the descriptor of the directory itself.
+  return count - 1;
+}
+
+//! Compute a percentile of a set of values.
+//! @param[in] values values (reordered).
+//! @param[in] p percentile between 0 and 1.
+//! @return percentile.
+static double
+percentile(std::vector<double>& values, double p)
+{
+  size_t n = (size_t)(p * (values.size() - 1) + 0.5);
+  std::nth_element(values.begin(), values.begin() + n, values.end());
+  return values[n];
+}
+
+//! Estimate the growth of a metric over the observation period with
+//! a least-squares line fit.
+//! @param[in] series metric samples.
+//! @param[in] first first sample considered.
+//! @param[out] baseline mean of the first quarter of the samples.
+//! @return growth over the observation period.
+static double
+computeGrowth(const Series& series, size_t first, double& baseline)
+{
+  size_t n = series.values.size() - first;
+  double mt = 0;
+  double mv = 0;
+  for (size_t i = first; i < series.values.size(); ++i)
+  {
+    mt += series.times[i];
+    mv += series.values[i];
+  }
+  mt /= n;
+  mv /= n;
+
+  double stv = 0;
+  double stt = 0;
+  for (size_t i = first; i < series.values.size(); ++i)
+  {
+    stv += (series.times[i] - mt) * (series.values[i] - mv);
+    stt += (series.times[i] - mt) * (series.times[i] - mt);
+  }
+
+  size_t quarter = std::max((size_t)1, n / 4);
+  baseline = 0;
+  for (size_t i = first; i < first + quarter; ++i)
+    baseline += series.values[i];
+  baseline /= quarter;
+
+  if (stt <= 0)
+    return 0;
+
+  return stv / stt * (series.times.back() - series.times[first]);
+}
+
+int
+main(int argc, char** argv)
+{
+  OptionParser options;
+  options.executable("dune-soak")
+  .program(DUNE_SHORT_NAME " Soak Test")
+  .copyright(DUNE_COPYRIGHT)
+  .email(DUNE_CONTACT)
+  .version(getFullVersion())
+  .date(getCompileDate())
+  .arch(DUNE_SYSTEM_NAME)
+  .description("Run a simulated vehicle for a long period of compressed "
+               "time executing repeated plans, and fail if resource usage "
+               "trends upward.")
+  .add("-d", "--config-dir",
+       "Configuration directory", "DIR")
+  .add("-c", "--config-file",
+       "Load configuration file CONFIG", "CONFIG")
+  .add("-p", "--profiles",
+       "Execution Profiles", "PROFILES")
+  .add("-s", "--speed",
+       "Time multiplier (default: 10)", "SPEED")
+  .add("-D", "--duration",
+       "Simulated duration in hours (default: 24)", "HOURS")
+  .add("-i", "--interval",
+       "Sampling interval in seconds of simulated time (default: 60)", "SECONDS")
+  .add("-w", "--warm-up",
+       "Fraction of the run ignored by the trend analysis (default: 0.2)", "FRACTION")
+  .add("-t", "--tolerance",
+       "Maximum relative growth of a metric (default: 0.1)", "FRACTION")
+  .add("-S", "--plan-size",
+       "Side of the square plan in meters (default: 200)", "METERS")
+  .add("-z", "--plan-depth",
+       "Depth of the square plan in meters (default: 0)", "METERS")
+  .add("-o", "--output",
+       "Write samples to CSV file FILE", "FILE");
+
+  if (!options.parse(argc, argv))
+  {
+    if (options.bad())
+      std::cerr << "ERROR: " << options.error() << std::endl;
+    options.usage();
+    return 1;
+  }
+
+  if (options.value("--config-file").empty())
+  {
+    std::cerr << "ERROR: no configuration file was given" << std::endl;
+    options.usage();
+    return 1;
+  }
+
+  double speed = 10.0;
+  double duration = 24.0;
+  double interval = 60.0;
+  double warm_up = 0.2;
+  double tolerance = 0.1;
+  double plan_size = 200.0;
+  double plan_depth = 0.0;
+
+  if ((!options.value("--speed").empty() && !castLexical(options.value("--speed"), speed))
+      || (!options.value("--duration").empty() && !castLexical(options.value("--duration"), duration))
+      || (!options.value("--interval").empty() && !castLexical(options.value("--interval"), interval))
+      || (!options.value("--warm-up").empty() && !castLexical(options.value("--warm-up"), warm_up))
+      || (!options.value("--tolerance").empty() && !castLexical(options.value("--tolerance"), tolerance))
+      || (!options.value("--plan-size").empty() && !castLexical(options.value("--plan-size"), plan_size))
+      || (!options.value("--plan-depth").empty() && !castLexical(options.value("--plan-depth"), plan_depth))
+      || speed <= 0 || duration <= 0 || interval <= 0 || warm_up < 0 || warm_up >= 1 || tolerance < 0)
+  {
+    std::cerr << "ERROR: invalid option value" << std::endl;
+    return 1;
+  }
+
+  std::ofstream* csv = NULL;
+  if (!options.value("--output").empty())
+  {
+    csv = new std::ofstream(options.value("--output").c_str());
+    if (!*csv)
+    {
+      std::cerr << "ERROR: failed to open " << options.value("--output") << std::endl;
+      delete csv;
+      return 1;
+    }
+  }
+
+  Time::Clock::setTimeMultiplier(speed);
+
+  Tasks::Context context;
+  I18N::setLanguage(context.dir_i18n);
+  Tasks::Factory::registerDynamicTasks(context.dir_lib.c_str());
+  registerStaticTasks();
+
+  if (!options.value("--config-dir").empty())
+    context.dir_cfg = options.value("--config-dir");
+
+  Series rss("RSS", "kB", 1024);
+  Series fds("File Descriptors", "", 2);
+  Series threads("Threads", "", 2);
+  Series queue("Queue Depth", "", 10);
+  Series p50("Latency p50", "ms", 1);
+  Series p95("Latency p95", "ms", 2);
+  Series p99("Latency p99", "ms", 5);
+  Series* all[] = {&rss, &fds, &threads, &queue, &p50, &p95, &p99};
+  const size_t all_count = sizeof(all) / sizeof(all[0]);
+
+  std::map<std::string, size_t> max_queues;
+  DUNE::Daemon* daemon = NULL;
+  Probe* probe = NULL;
+  bool died = false;
+  int rv = 0;
+
+  try
+  {
+    Path cfg_file = context.dir_cfg / options.value("--config-file") + ".ini";
+    context.config.parseFile(cfg_file.c_str());
+    context.original_cfg.parseFile(cfg_file.c_str());
+    context.config.set("Soak", "Entity Label", "Soak Test");
+
+    daemon = new DUNE::Daemon(context, options.value("--profiles"));
+
+    probe = new Probe(context, plan_size, plan_depth, 1.5);
+    probe->loadConfig();
+    probe->reserveEntities();
+
+    setSoakSignalHandlers();
+    daemon->start();
+    probe->start();
+
+    if (csv != NULL)
+    {
+      *csv << "time";
+      for (size_t i = 0; i < all_count; ++i)
+        *csv << "," << all[i]->name;
+      *csv << std::endl;
+    }
+
+    double start = Clock::get();
+    double end = start + duration * 3600.0;
+    std::vector<double> delays;
+
+    while (!s_stop && Clock::get() < end)
+    {
+      Delay::wait(interval);
+
+      if (!daemon->isRunning())
+      {
+        died = true;
+        break;
+      }
+
+      double t = Clock::get() - start;
+      rss.add(t, readStatus("VmRSS"));
+      fds.add(t, countDescriptors());
+      threads.add(t, readStatus("Threads"));
+
+      size_t depth = 0;
+      Tasks::Manager* manager = daemon->getTaskManager();
+      std::map<std::string, Tasks::Task*>::iterator itr = manager->begin();
+      for (; itr != manager->end(); ++itr)
+      {
+        size_t size = itr->second->getQueueSize();
+        max_queues[itr->first] = std::max(max_queues[itr->first], size);
+        depth = std::max(depth, size);
+      }
+      queue.add(t, depth);
+
+      probe->takeLatencies(delays);
+      if (!delays.empty())
+      {
+        p50.add(t, percentile(delays, 0.50) * 1000.0);
+        p95.add(t, percentile(delays, 0.95) * 1000.0);
+        p99.add(t, percentile(delays, 0.99) * 1000.0);
+      }
+
+      if (csv != NULL)
+      {
+        *csv << std::fixed << std::setprecision(3) << t;
+        for (size_t i = 0; i < all_count; ++i)
+        {
+          *csv << ",";
+          if (!all[i]->times.empty() && all[i]->times.back() == t)
+            *csv << all[i]->values.back();
+        }
+        *csv << std::endl;
+      }
+
+      std::cerr << String::str("soak: %.1f h, rss %.0f kB, fds %.0f, threads %.0f, queue %u, plans %u/%u",
+                               t / 3600.0, rss.values.empty() ? 0.0 : rss.values.back(),
+                               fds.values.empty() ? 0.0 : fds.values.back(),
+                               threads.values.empty() ? 0.0 : threads.values.back(),
+                               (unsigned)depth, probe->getSucceeded(), probe->getStarted())
+                << std::endl;
+    }
+
+    probe->stopAndJoin();
+    daemon->stop();
+    daemon->join();
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    rv = 1;
+  }
+
+  if (rv == 0)
+  {
+    std::cout << std::endl
+              << "Plans: " << probe->getStarted() << " started, "
+              << probe->getSucceeded() << " succeeded, "
+              << probe->getFailed() << " failed" << std::endl
+              << std::endl;
+
+    std::cout << std::left << std::setw(20) << "Metric"
+              << std::right << std::setw(14) << "Baseline"
+              << std::setw(14) << "Growth"
+              << std::setw(14) << "Limit"
+              << "  Result" << std::endl;
+
+    for (size_t i = 0; i < all_count; ++i)
+    {
+      const Series& s = *all[i];
+      size_t first = 0;
+      while (first < s.times.size() && s.times[first] < warm_up * s.times.back())
+        ++first;
+
+      std::cout << std::left << std::setw(20) << s.name << std::right << std::fixed << std::setprecision(2);
+
+      if (s.values.size() < first + 4)
+      {
+        std::cout << std::setw(44) << "" << "  not enough samples" << std::endl;
+        continue;
+      }
+
+      double baseline = 0;
+      double growth = computeGrowth(s, first, baseline);
+      double limit = std::max(s.floor, tolerance * baseline);
+      bool drift = growth > limit;
+
+      std::cout << std::setw(14) << baseline
+                << std::setw(14) << growth
+                << std::setw(14) << limit
+                << "  " << (drift ? "DRIFT" : "ok") << std::endl;
+
+      if (drift)
+        rv = 1;
+    }
+
+    std::cout << std::endl << "Deepest queues:" << std::endl;
+    std::vector<std::pair<size_t, std::string> > deepest;
+    std::map<std::string, size_t>::const_iterator itr = max_queues.begin();
+    for (; itr != max_queues.end(); ++itr)
+      deepest.push_back(std::make_pair(itr->second, itr->first));
+    std::sort(deepest.rbegin(), deepest.rend());
+    for (size_t i = 0; i < deepest.size() && i < 5; ++i)
+      std::cout << "  " << std::left << std::setw(40) << deepest[i].second << deepest[i].first << std::endl;
+
+    if (died)
+    {
+      std::cout << std::endl << "ERROR: vehicle stopped before the end of the test" << std::endl;
+      rv = 1;
+    }
+  }
+
+  delete probe;
+  delete daemon;
+  delete csv;
+
+  return rv;
+}
@@ -131,7 +131,7 @@ namespace Monitors
 
         while (!stopping())
         {
-          waitForMessages(1.0);
+          waitForMessages();
         }
       }
 
@@ -215,6 +215,8 @@ namespace Monitors
           war(DTR("failed to resolve entity '%s': %s"), m_args.elabel_device.c_str(), e.what());
           m_device_eid = UINT_MAX;
         }
+
+        setSource<IMC::Acceleration>(IMC::SourcePredicate::fromEntity(m_device_eid));
       }
 
       void
@@ -229,9 +231,6 @@ namespace Monitors
       void
       consume(const IMC::Acceleration* msg)
       {
-        if (msg->getSourceEntity() != m_device_eid)
-          return;
-
         // Activate task if not active.
         if (!isActive())
         {
@@ -459,7 +459,7 @@ namespace Monitors
       {
         while (!stopping())
         {
-          waitForMessages(1.0);
+          waitForMessages();
         }
       }
     };
@@ -99,7 +99,7 @@ namespace Monitors
       {
         while (!stopping())
         {
-          waitForMessages(1.0);
+          waitForMessages();
         }
       }
     };
@@ -0,0 +1,201 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef MONITORS_OBSTACLES_GRID_HPP_INCLUDED_
+#define MONITORS_OBSTACLES_GRID_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <map>
+#include <utility>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Monitors
+{
+  namespace Obstacles
+  {
+    using DUNE_NAMESPACES;
+
+    //! Sparse grid of obstacle evidence. Cells are indexed in the
+    //! local navigation frame so that detections stay put while the
+    //! vehicle moves, and their evidence decays exponentially with
+    //! time.
+    class Grid
+    {
+    public:
+      //! Constructor.
+      //! @param[in] cell_size cell size (m).
+      //! @param[in] decay_time evidence time constant (s).
+      Grid(double cell_size, double decay_time):
+        m_cell_size(cell_size),
+        m_decay_time(decay_time)
+      { }
+
+      //! Remove all cells.
+      void
+      clear(void)
+      {
+        m_cells.clear();
+      }
+
+      //! Get number of cells.
+      //! @return number of cells.
+      size_t
+      size(void) const
+      {
+        return m_cells.size();
+      }
+
+      //! Add evidence to the cell containing a point.
+      //! @param[in] x north coordinate (m).
+      //! @param[in] y east coordinate (m).
+      //! @param[in] weight evidence to add.
+      //! @param[in] now current time.
+      void
+      hit(double x, double y, double weight, double now)
+      {
+        Cell& cell = m_cells[index(x, y)];
+        cell.value = std::min(1.0, decayed(cell, now) + weight);
+        cell.stamp = now;
+      }
+
+      //! Scale the evidence of the cell containing a point, used
+      //! to clear cells a beam went through without returns.
+      //! @param[in] x north coordinate (m).
+      //! @param[in] y east coordinate (m).
+      //! @param[in] factor scale factor.
+      //! @param[in] now current time.
+      void
+      miss(double x, double y, double factor, double now)
+      {
+        Map::iterator itr = m_cells.find(index(x, y));
+        if (itr == m_cells.end())
+          return;
+
+        itr->second.value = decayed(itr->second, now) * factor;
+        itr->second.stamp = now;
+      }
+
+      //! Drop cells whose evidence is negligible.
+      //! @param[in] now current time.
+      //! @param[in] floor evidence below which cells are dropped.
+      void
+      prune(double now, double floor)
+      {
+        Map::iterator itr = m_cells.begin();
+        while (itr != m_cells.end())
+        {
+          if (decayed(itr->second, now) < floor)
+            m_cells.erase(itr++);
+          else
+            ++itr;
+        }
+      }
+
+      //! Find the closest occupied cell inside an angular sector.
+      //! @param[in] x north coordinate of the sector apex (m).
+      //! @param[in] y east coordinate of the sector apex (m).
+      //! @param[in] heading sector bisector (rad).
+      //! @param[in] half_width sector half width (rad).
+      //! @param[in] threshold minimum evidence of occupied cells.
+      //! @param[in] now current time.
+      //! @return distance to the closest cell or -1 if none.
+      double
+      closest(double x, double y, double heading, double half_width,
+              double threshold, double now) const
+      {
+        double best = -1;
+
+        Map::const_iterator itr = m_cells.begin();
+        for (; itr != m_cells.end(); ++itr)
+        {
+          if (decayed(itr->second, now) < threshold)
+            continue;
+
+          double dx = (itr->first.first + 0.5) * m_cell_size - x;
+          double dy = (itr->first.second + 0.5) * m_cell_size - y;
+          double bearing = Angles::normalizeRadian(std::atan2(dy, dx) - heading);
+          if (std::fabs(bearing) > half_width)
+            continue;
+
+          double range = std::sqrt(dx * dx + dy * dy);
+          if (best < 0 || range < best)
+            best = range;
+        }
+
+        return best;
+      }
+
+    private:
+      //! Cell state.
+      struct Cell
+      {
+        //! Evidence at time of last update.
+        double value;
+        //! Time of last update.
+        double stamp;
+
+        Cell(void):
+          value(0),
+          stamp(0)
+        { }
+      };
+
+      typedef std::pair<int, int> Index;
+      typedef std::map<Index, Cell> Map;
+
+      //! Cell size.
+      double m_cell_size;
+      //! Evidence time constant.
+      double m_decay_time;
+      //! Cells.
+      Map m_cells;
+
+      Index
+      index(double x, double y) const
+      {
+        return Index((int)std::floor(x / m_cell_size),
+                     (int)std::floor(y / m_cell_size));
+      }
+
+      double
+      decayed(const Cell& cell, double now) const
+      {
+        if (cell.stamp <= 0)
+          return cell.value;
+
+        return cell.value * std::exp(-(now - cell.stamp) / m_decay_time);
+      }
+    };
+  }
+}
+
+#endif
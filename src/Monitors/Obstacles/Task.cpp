@@ -0,0 +1,487 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Grid.hpp"
+
+namespace Monitors
+{
+  //! This task extracts obstacles from the pings of a sonar
+  //! (SonarData), accumulates them in a decaying evidence grid and
+  //! reports the clearance ahead of the vehicle as a forward looking
+  //! Distance message, as consumed by the bottom tracker of path
+  //! controllers.
+  //!
+  //! Returns are detected with a cell-averaging constant false alarm
+  //! rate detector, so the threshold follows the noise floor of each
+  //! ping. The beam direction of a ping is taken from the Distance
+  //! message the sonar driver dispatches along with it.
+  //!
+  //! @author agent
+  namespace Obstacles
+  {
+    using DUNE_NAMESPACES;
+
+    //! Evidence below which grid cells are dropped.
+    static const double c_prune_floor = 0.01;
+    //! Grid pruning period.
+    static const double c_prune_period = 1.0;
+
+    //! %Task arguments.
+    struct Arguments
+    {
+      //! Sonar entity label.
+      std::string elabel_sonar;
+      //! Maximum range.
+      double max_range;
+      //! Blanking range.
+      double blank_range;
+      //! Detector training cells.
+      unsigned train_cells;
+      //! Detector guard cells.
+      unsigned guard_cells;
+      //! Detection factor.
+      double det_factor;
+      //! Minimum intensity.
+      double min_intensity;
+      //! Grid cell size.
+      double cell_size;
+      //! Evidence decay time.
+      double decay_time;
+      //! Evidence added per detection.
+      double hit_weight;
+      //! Evidence kept by cells crossed without returns.
+      double miss_factor;
+      //! Occupancy threshold.
+      double occ_threshold;
+      //! Clearance sector width.
+      double sector_width;
+    };
+
+    struct Task: public DUNE::Tasks::Task
+    {
+      //! Task arguments.
+      Arguments m_args;
+      //! Obstacle grid.
+      Grid* m_grid;
+      //! Sonar entity.
+      unsigned m_sonar_eid;
+      //! Last sonar beam location.
+      IMC::DeviceState m_beam;
+      //! Last estimated state.
+      IMC::EstimatedState m_estate;
+      //! True if an estimated state was received.
+      bool m_have_state;
+      //! Clearance report.
+      IMC::Distance m_clearance;
+      //! Normalized ping intensities.
+      std::vector<double> m_bins;
+      //! Prefix sums of ping intensities.
+      std::vector<double> m_sums;
+      //! Grid pruning timer.
+      Time::Counter<double> m_prune_timer;
+      //! True once pings are being processed.
+      bool m_processing;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        DUNE::Tasks::Task(name, ctx),
+        m_grid(NULL),
+        m_sonar_eid(UINT_MAX),
+        m_have_state(false),
+        m_processing(false)
+      {
+        param("Entity Label - Sonar", m_args.elabel_sonar)
+        .defaultValue("Pencil Beam")
+        .description("Entity label of the sonar whose pings are processed");
+
+        param("Maximum Range", m_args.max_range)
+        .defaultValue("50")
+        .minimumValue("1")
+        .units(Units::Meter)
+        .description("Returns beyond this range are ignored");
+
+        param("Blanking Range", m_args.blank_range)
+        .defaultValue("1")
+        .minimumValue("0")
+        .units(Units::Meter)
+        .description("Returns closer than this range are ignored");
+
+        param("Detector Training Cells", m_args.train_cells)
+        .defaultValue("16")
+        .minimumValue("2")
+        .description("Number of bins on each side used to estimate the noise floor");
+
+        param("Detector Guard Cells", m_args.guard_cells)
+        .defaultValue("2")
+        .description("Number of bins on each side excluded from the noise floor");
+
+        param("Detection Factor", m_args.det_factor)
+        .defaultValue("3")
+        .minimumValue("1")
+        .description("Ratio between a return and the noise floor to declare a detection");
+
+        param("Minimum Intensity", m_args.min_intensity)
+        .defaultValue("20")
+        .minimumValue("0")
+        .maximumValue("100")
+        .units(Units::Percentage)
+        .description("Minimum return intensity, relative to full scale");
+
+        param("Cell Size", m_args.cell_size)
+        .defaultValue("0.5")
+        .minimumValue("0.05")
+        .units(Units::Meter)
+        .description("Size of the obstacle grid cells");
+
+        param("Decay Time", m_args.decay_time)
+        .defaultValue("10")
+        .minimumValue("0.1")
+        .units(Units::Second)
+        .description("Time constant of obstacle evidence decay");
+
+        param("Hit Weight", m_args.hit_weight)
+        .defaultValue("0.35")
+        .minimumValue("0")
+        .maximumValue("1")
+        .description("Evidence added to a cell for each detection");
+
+        param("Miss Factor", m_args.miss_factor)
+        .defaultValue("0.7")
+        .minimumValue("0")
+        .maximumValue("1")
+        .description("Fraction of evidence kept by cells a beam crossed without returns");
+
+        param("Occupancy Threshold", m_args.occ_threshold)
+        .defaultValue("0.6")
+        .minimumValue("0")
+        .maximumValue("1")
+        .description("Evidence above which a cell is reported as an obstacle");
+
+        param("Clearance Sector Width", m_args.sector_width)
+        .defaultValue("30")
+        .minimumValue("1")
+        .maximumValue("360")
+        .units(Units::Degree)
+        .description("Width of the sector ahead of the vehicle searched for obstacles");
+
+        bind<IMC::Distance>(this);
+        bind<IMC::EstimatedState>(this, IMC::SourcePredicate::fromSystem(getSystemId()));
+        bind<IMC::SonarData>(this);
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        if (paramChanged(m_args.min_intensity))
+          m_args.min_intensity *= 0.01;
+
+        if (paramChanged(m_args.sector_width))
+          m_args.sector_width = Angles::radians(m_args.sector_width);
+
+        IMC::DeviceState ds;
+        m_clearance.location.clear();
+        m_clearance.location.push_back(ds);
+
+        IMC::BeamConfig bc;
+        bc.beam_width = m_args.sector_width;
+        bc.beam_height = m_args.sector_width;
+        m_clearance.beam_config.clear();
+        m_clearance.beam_config.push_back(bc);
+
+        m_prune_timer.setTop(c_prune_period);
+
+        if (m_grid != NULL)
+        {
+          Memory::clear(m_grid);
+          m_grid = new Grid(m_args.cell_size, m_args.decay_time);
+        }
+      }
+
+      void
+      onEntityResolution(void)
+      {
+        try
+        {
+          m_sonar_eid = resolveEntity(m_args.elabel_sonar);
+        }
+        catch (std::runtime_error& e)
+        {
+          war(DTR("failed to resolve entity '%s': %s"), m_args.elabel_sonar.c_str(), e.what());
+          m_sonar_eid = UINT_MAX;
+        }
+
+        setSource<IMC::Distance>(IMC::SourcePredicate::fromEntity(m_sonar_eid));
+        setSource<IMC::SonarData>(IMC::SourcePredicate::fromEntity(m_sonar_eid));
+      }
+
+      void
+      onResourceAcquisition(void)
+      {
+        m_grid = new Grid(m_args.cell_size, m_args.decay_time);
+      }
+
+      void
+      onResourceInitialization(void)
+      {
+        setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_IDLE);
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        Memory::clear(m_grid);
+      }
+
+      void
+      consume(const IMC::Distance* msg)
+      {
+        if (msg->location.size())
+          m_beam = *(*msg->location.begin());
+      }
+
+      void
+      consume(const IMC::EstimatedState* msg)
+      {
+        // Grid cells are relative to the navigation reference.
+        if (m_have_state && (msg->lat != m_estate.lat || msg->lon != m_estate.lon
+                             || msg->height != m_estate.height))
+          m_grid->clear();
+
+        m_estate = *msg;
+        m_have_state = true;
+      }
+
+      void
+      consume(const IMC::SonarData* msg)
+      {
+        if (!m_have_state || m_grid == NULL)
+          return;
+
+        if (!decode(msg))
+          return;
+
+        double now = msg->getTimeStamp();
+        updateGrid(msg, now);
+
+        if (m_prune_timer.overflow())
+        {
+          m_grid->prune(now, c_prune_floor);
+          m_prune_timer.reset();
+        }
+
+        double range = m_grid->closest(m_estate.x, m_estate.y, m_estate.psi,
+                                       m_args.sector_width / 2.0,
+                                       m_args.occ_threshold, now);
+
+        m_clearance.validity = IMC::Distance::DV_VALID;
+        m_clearance.value = range < 0 ? m_args.max_range : range;
+        m_clearance.setTimeStamp(now);
+        dispatch(m_clearance, DF_KEEP_TIME);
+
+        if (!m_processing)
+        {
+          setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+          m_processing = true;
+        }
+      }
+
+      //! Decode ping intensities normalized to full scale.
+      //! @param[in] msg ping.
+      //! @return true if the ping was decoded, false otherwise.
+      bool
+      decode(const IMC::SonarData* msg)
+      {
+        unsigned bytes = msg->bits_per_point / 8;
+        if (bytes != 1 && bytes != 2 && bytes != 4)
+          return false;
+
+        size_t count = msg->data.size() / bytes;
+        if (count == 0)
+          return false;
+
+        double full = std::pow(2.0, (double)msg->bits_per_point) - 1.0;
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(&msg->data[0]);
+
+        m_bins.resize(count);
+        m_sums.resize(count + 1);
+        m_sums[0] = 0;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+          uint32_t v = 0;
+          if (bytes == 1)
+          {
+            v = data[i];
+          }
+          else if (bytes == 2)
+          {
+            uint16_t t = 0;
+            ByteCopy::fromLE(t, data + i * 2);
+            v = t;
+          }
+          else
+          {
+            ByteCopy::fromLE(v, data + i * 4);
+          }
+
+          m_bins[i] = v / full;
+          m_sums[i + 1] = m_sums[i] + m_bins[i];
+        }
+
+        return true;
+      }
+
+      //! Check if a bin stands out of its noise floor.
+      //! @param[in] i bin index.
+      //! @return true if detected, false otherwise.
+      bool
+      detected(size_t i) const
+      {
+        if (m_bins[i] < m_args.min_intensity)
+          return false;
+
+        size_t n = m_bins.size();
+        size_t gap = m_args.guard_cells + 1;
+        size_t span = m_args.guard_cells + m_args.train_cells;
+        double sum = 0;
+        size_t cells = 0;
+
+        // Leading training cells.
+        if (i >= gap)
+        {
+          size_t end = i - gap + 1;
+          size_t begin = i >= span ? i - span : 0;
+          sum += m_sums[end] - m_sums[begin];
+          cells += end - begin;
+        }
+
+        // Lagging training cells.
+        if (i + gap < n)
+        {
+          size_t begin = i + gap;
+          size_t end = std::min(n, i + span + 1);
+          sum += m_sums[end] - m_sums[begin];
+          cells += end - begin;
+        }
+
+        if (cells == 0)
+          return false;
+
+        return m_bins[i] > m_args.det_factor * (sum / cells);
+      }
+
+      //! Convert a point along the current beam to the navigation frame.
+      //! @param[in] range range along the beam.
+      //! @param[out] x north coordinate.
+      //! @param[out] y east coordinate.
+      void
+      toNavigation(double range, double& x, double& y) const
+      {
+        double horizontal = range * std::cos(m_beam.theta);
+        double bx = m_beam.x + horizontal * std::cos(m_beam.psi);
+        double by = m_beam.y + horizontal * std::sin(m_beam.psi);
+
+        x = m_estate.x + bx * std::cos(m_estate.psi) - by * std::sin(m_estate.psi);
+        y = m_estate.y + bx * std::sin(m_estate.psi) + by * std::cos(m_estate.psi);
+      }
+
+      //! Update the grid with the detections of a ping.
+      //! @param[in] msg ping.
+      //! @param[in] now ping time.
+      void
+      updateGrid(const IMC::SonarData* msg, double now)
+      {
+        size_t n = m_bins.size();
+        double min = msg->min_range;
+        double step = (msg->max_range - min) / n;
+        if (step <= 0)
+          return;
+
+        double first = -1;
+        double x = 0;
+        double y = 0;
+        // Peak of the current run of consecutive detections.
+        size_t peak = n;
+
+        for (size_t i = 0; i <= n; ++i)
+        {
+          double range = min + (i + 0.5) * step;
+          bool hit = (i < n) && (range >= m_args.blank_range)
+                     && (range <= m_args.max_range) && detected(i);
+
+          if (hit)
+          {
+            if (peak == n || m_bins[i] > m_bins[peak])
+              peak = i;
+            continue;
+          }
+
+          if (peak == n)
+            continue;
+
+          double peak_range = min + (peak + 0.5) * step;
+          if (first < 0)
+            first = peak_range;
+
+          toNavigation(peak_range, x, y);
+          m_grid->hit(x, y, m_args.hit_weight, now);
+          peak = n;
+        }
+
+        // Cells before the first return are free.
+        double clear = first < 0 ? std::min(m_args.max_range, (double)msg->max_range) : first;
+        clear -= m_args.cell_size;
+        for (double r = m_args.blank_range; r < clear; r += m_args.cell_size)
+        {
+          toNavigation(r, x, y);
+          m_grid->miss(x, y, m_args.miss_factor, now);
+        }
+      }
+
+      void
+      onMain(void)
+      {
+        while (!stopping())
+        {
+          waitForMessages();
+        }
+      }
+    };
+  }
+}
+
+DUNE_TASK
@@ -0,0 +1,506 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Monitors
+{
+  //! This task turns the raw stream of a CTD or water quality sensor
+  //! into compact vertical profiles.
+  //!
+  //! Samples are grouped in bins of fixed depth or of fixed duration,
+  //! keeping a running mean of each water property. Depth bins gather
+  //! every sample taken at their depth during a cast, however many
+  //! times the vehicle crosses them. When bins close, their means
+  //! become samples of the profile being built for each property, in
+  //! order of depth. Profiles are dispatched as VerticalProfile
+  //! messages when the vehicle reverses its vertical direction (end of
+  //! a cast) or when they hold the maximum number of bins.
+  //!
+  //! Salinity is derived from conductivity, temperature and depth
+  //! (UNESCO 1983) when the sensor does not report it.
+  //!
+  //! @author agent
+  namespace ScienceProfiles
+  {
+    using DUNE_NAMESPACES;
+
+    //! Number of profiled water properties (see VerticalProfile).
+    static const unsigned c_properties = IMC::VerticalProfile::PROF_TURBIDITY + 1;
+    //! Time after which salinity is derived if the sensor does not report it.
+    static const double c_salinity_timeout = 5.0;
+    //! Maximum age of temperature used to derive salinity.
+    static const double c_temperature_timeout = 2.0;
+    //! Maximum depth that fits in a profile sample (m).
+    static const double c_max_depth = 6553.5;
+
+    //! %Task arguments.
+    struct Arguments
+    {
+      //! Entity label of the sensor.
+      std::string label_source;
+      //! Binning mode.
+      std::string binning;
+      //! Depth bin size.
+      double bin_depth;
+      //! Time bin size.
+      double bin_time;
+      //! Minimum number of samples in a valid bin.
+      unsigned min_samples;
+      //! Maximum number of bins in a profile.
+      unsigned max_bins;
+      //! Depth reversal that ends a cast.
+      double hysteresis;
+    };
+
+    //! Running statistics of a quantity.
+    struct Statistic
+    {
+      //! Number of samples.
+      unsigned count;
+      //! Mean of samples.
+      double mean;
+
+      Statistic(void):
+        count(0),
+        mean(0.0)
+      { }
+
+      void
+      add(double value)
+      {
+        ++count;
+        mean += (value - mean) / count;
+      }
+    };
+
+    //! Samples of a depth or time bin.
+    struct Bin
+    {
+      //! Water properties.
+      Statistic props[c_properties];
+      //! Depth at which properties were sampled.
+      Statistic depth;
+      //! Index of depth bin.
+      long index;
+    };
+
+    struct Task: public DUNE::Tasks::Task
+    {
+      //! Task arguments.
+      Arguments m_args;
+      //! True if binning by depth, false if by time.
+      bool m_by_depth;
+      //! Sensor entity id.
+      unsigned m_source_eid;
+      //! Bins of the current cast by depth index (a single bin when
+      //! binning by time).
+      std::map<long, Bin> m_bins;
+      //! Profiles being built.
+      IMC::VerticalProfile m_profiles[c_properties];
+      //! Vehicle depth.
+      double m_depth;
+      //! True if vehicle depth is known.
+      bool m_depth_valid;
+      //! Vehicle position.
+      double m_lat, m_lon;
+      //! Vertical direction (1 descending, -1 ascending).
+      int m_direction;
+      //! Deepest/shallowest depth of the current cast.
+      double m_extreme;
+      //! Last temperature.
+      double m_temp;
+      //! Time of the last temperature.
+      double m_temp_time;
+      //! Time of the last salinity reported by the sensor.
+      double m_sali_time;
+      //! Bin timer.
+      Time::Counter<double> m_bin_timer;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        DUNE::Tasks::Task(name, ctx),
+        m_by_depth(true),
+        m_source_eid(UINT_MAX),
+        m_depth(0.0),
+        m_depth_valid(false),
+        m_lat(0.0),
+        m_lon(0.0),
+        m_direction(1),
+        m_extreme(0.0),
+        m_temp(0.0),
+        m_temp_time(-1.0),
+        m_sali_time(-1.0)
+      {
+        param("Source Entity Label", m_args.label_source)
+        .defaultValue("CTD")
+        .description("Entity label of the CTD or water quality sensor");
+
+        param("Binning", m_args.binning)
+        .defaultValue("Depth")
+        .values("Depth, Time")
+        .description("Group samples in bins of fixed depth or fixed duration");
+
+        param("Bin Size - Depth", m_args.bin_depth)
+        .defaultValue("1.0")
+        .minimumValue("0.1")
+        .units(Units::Meter)
+        .description("Height of depth bins");
+
+        param("Bin Size - Time", m_args.bin_time)
+        .defaultValue("10.0")
+        .minimumValue("0.5")
+        .units(Units::Second)
+        .description("Duration of time bins");
+
+        param("Minimum Samples per Bin", m_args.min_samples)
+        .defaultValue("3")
+        .minimumValue("1")
+        .description("Bins with fewer samples of a property are discarded");
+
+        param("Maximum Bins per Profile", m_args.max_bins)
+        .defaultValue("32")
+        .minimumValue("1")
+        .maximumValue("255")
+        .description("Profiles are dispatched when they reach this number of bins");
+
+        param("Cast Hysteresis", m_args.hysteresis)
+        .defaultValue("1.0")
+        .minimumValue("0.1")
+        .units(Units::Meter)
+        .description("Reversal of depth that ends a cast and dispatches its profiles");
+
+        for (unsigned i = 0; i < c_properties; ++i)
+          m_profiles[i].parameter = i;
+
+        bind<IMC::EstimatedState>(this);
+        bind<IMC::Temperature>(this);
+        bind<IMC::Conductivity>(this);
+        bind<IMC::Salinity>(this);
+        bind<IMC::PH>(this);
+        bind<IMC::Redox>(this);
+        bind<IMC::Chlorophyll>(this);
+        bind<IMC::Turbidity>(this);
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        m_by_depth = (m_args.binning == "Depth");
+        m_bin_timer.setTop(m_args.bin_time);
+      }
+
+      void
+      onEntityResolution(void)
+      {
+        try
+        {
+          m_source_eid = resolveEntity(m_args.label_source);
+        }
+        catch (...)
+        {
+          m_source_eid = UINT_MAX;
+          war(DTR("unknown source entity: %s"), m_args.label_source.c_str());
+        }
+      }
+
+      void
+      onResourceInitialization(void)
+      {
+        m_bins.clear();
+        m_bin_timer.reset();
+        setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        closeBins();
+        dispatchProfiles();
+      }
+
+      void
+      consume(const IMC::EstimatedState* msg)
+      {
+        if (msg->getSource() != getSystemId())
+          return;
+
+        Coordinates::toWGS84(*msg, m_lat, m_lon);
+        m_depth = msg->depth;
+
+        if (!m_depth_valid)
+        {
+          m_depth_valid = true;
+          m_extreme = m_depth;
+          return;
+        }
+
+        if (castEnded())
+        {
+          closeBins();
+          dispatchProfiles();
+        }
+      }
+
+      void
+      consume(const IMC::Temperature* msg)
+      {
+        if (!isFromSource(msg))
+          return;
+
+        m_temp = msg->value;
+        m_temp_time = msg->getTimeStamp();
+        addSample(IMC::VerticalProfile::PROF_TEMPERATURE, msg->value);
+      }
+
+      void
+      consume(const IMC::Conductivity* msg)
+      {
+        if (!isFromSource(msg))
+          return;
+
+        addSample(IMC::VerticalProfile::PROF_CONDUCTIVITY, msg->value);
+
+        // Derive salinity if the sensor does not report it.
+        double now = msg->getTimeStamp();
+        if (now - m_sali_time < c_salinity_timeout)
+          return;
+
+        if (m_temp_time < 0.0 || now - m_temp_time > c_temperature_timeout)
+          return;
+
+        double salinity = UNESCO1983::computeSalinity(msg->value, m_depth / 10.0, m_temp);
+        if (salinity >= 0.0)
+          addSample(IMC::VerticalProfile::PROF_SALINITY, salinity);
+      }
+
+      void
+      consume(const IMC::Salinity* msg)
+      {
+        if (!isFromSource(msg))
+          return;
+
+        m_sali_time = msg->getTimeStamp();
+        addSample(IMC::VerticalProfile::PROF_SALINITY, msg->value);
+      }
+
+      void
+      consume(const IMC::PH* msg)
+      {
+        if (isFromSource(msg))
+          addSample(IMC::VerticalProfile::PROF_PH, msg->value);
+      }
+
+      void
+      consume(const IMC::Redox* msg)
+      {
+        if (isFromSource(msg))
+          addSample(IMC::VerticalProfile::PROF_REDOX, msg->value);
+      }
+
+      void
+      consume(const IMC::Chlorophyll* msg)
+      {
+        if (isFromSource(msg))
+          addSample(IMC::VerticalProfile::PROF_CHLOROPHYLL, msg->value);
+      }
+
+      void
+      consume(const IMC::Turbidity* msg)
+      {
+        if (isFromSource(msg))
+          addSample(IMC::VerticalProfile::PROF_TURBIDITY, msg->value);
+      }
+
+      //! Check if a message was produced by the sensor.
+      //! @param[in] msg message.
+      //! @return true if message is from the sensor, false otherwise.
+      bool
+      isFromSource(const IMC::Message* msg) const
+      {
+        return msg->getSource() == getSystemId()
+        && msg->getSourceEntity() == m_source_eid;
+      }
+
+      //! Compute the index of the depth bin of the vehicle.
+      //! @return depth bin index.
+      long
+      depthIndex(void) const
+      {
+        if (!m_by_depth)
+          return 0;
+
+        return (long)std::floor(m_depth / m_args.bin_depth);
+      }
+
+      //! Track the vertical direction of the vehicle.
+      //! @return true if the vehicle reversed its direction.
+      bool
+      castEnded(void)
+      {
+        if (m_direction > 0)
+        {
+          m_extreme = std::max(m_extreme, m_depth);
+          if (m_extreme - m_depth < m_args.hysteresis)
+            return false;
+        }
+        else
+        {
+          m_extreme = std::min(m_extreme, m_depth);
+          if (m_depth - m_extreme < m_args.hysteresis)
+            return false;
+        }
+
+        m_direction = -m_direction;
+        m_extreme = m_depth;
+        return true;
+      }
+
+      //! Add a sample of a water property to the current bin.
+      //! @param[in] prop water property.
+      //! @param[in] value sample value.
+      void
+      addSample(unsigned prop, double value)
+      {
+        if (!m_depth_valid)
+          return;
+
+        if (!m_by_depth && m_bin_timer.overflow())
+        {
+          closeBins();
+          m_bin_timer.reset();
+        }
+
+        long index = depthIndex();
+        if (m_bins.find(index) == m_bins.end() && m_bins.size() >= m_args.max_bins)
+        {
+          closeBins();
+          dispatchProfiles();
+        }
+
+        Bin& bin = m_bins[index];
+        bin.index = index;
+        bin.props[prop].add(value);
+        bin.depth.add(m_depth);
+      }
+
+      //! Append the statistics of a bin to the profiles.
+      //! @param[in] bin bin.
+      void
+      closeBin(const Bin& bin)
+      {
+        if (!bin.depth.count)
+          return;
+
+        double depth = bin.depth.mean;
+        if (m_by_depth)
+          depth = (bin.index + 0.5) * m_args.bin_depth;
+
+        depth = trimValue(depth, 0.0, c_max_depth);
+
+        for (unsigned i = 0; i < c_properties; ++i)
+        {
+          if (bin.props[i].count < m_args.min_samples)
+            continue;
+
+          IMC::ProfileSample sample;
+          sample.depth = (uint16_t)Math::round(depth * 10.0);
+          sample.avg = bin.props[i].mean;
+          m_profiles[i].samples.push_back(sample);
+
+          if (m_profiles[i].samples.size() >= m_args.max_bins)
+            dispatchProfile(m_profiles[i]);
+        }
+      }
+
+      //! Append all bins to the profiles, in order of depth, and
+      //! start over.
+      void
+      closeBins(void)
+      {
+        std::map<long, Bin>::const_iterator itr = m_bins.begin();
+        for (; itr != m_bins.end(); ++itr)
+          closeBin(itr->second);
+
+        m_bins.clear();
+      }
+
+      //! Dispatch a profile and start a new one.
+      //! @param[in] profile profile.
+      void
+      dispatchProfile(IMC::VerticalProfile& profile)
+      {
+        if (profile.samples.empty())
+          return;
+
+        profile.numsamples = profile.samples.size();
+        profile.lat = m_lat;
+        profile.lon = m_lon;
+        dispatch(profile);
+
+        debug("dispatched profile %u with %u samples",
+              profile.parameter, profile.numsamples);
+
+        profile.samples.clear();
+      }
+
+      //! Dispatch all profiles.
+      void
+      dispatchProfiles(void)
+      {
+        for (unsigned i = 0; i < c_properties; ++i)
+          dispatchProfile(m_profiles[i]);
+      }
+
+      void
+      onMain(void)
+      {
+        while (!stopping())
+        {
+          waitForMessages(1.0);
+
+          if (!m_by_depth && m_bin_timer.overflow())
+          {
+            closeBins();
+            m_bin_timer.reset();
+          }
+        }
+      }
+    };
+  }
+}
+
+DUNE_TASK
@@ -0,0 +1,174 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef MONITORS_TRAFFIC_INDEX_HPP_INCLUDED_
+#define MONITORS_TRAFFIC_INDEX_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Monitors
+{
+  namespace Traffic
+  {
+    using DUNE_NAMESPACES;
+
+    //! Uniform grid spatial index of contacts in the local
+    //! navigation frame. Only occupied cells are stored, so that
+    //! neighbourhood queries cost is proportional to the number of
+    //! contacts nearby instead of the size of the traffic picture.
+    class Index
+    {
+    public:
+      //! Constructor.
+      //! @param[in] cell_size cell size (m).
+      Index(double cell_size):
+        m_cell_size(cell_size)
+      { }
+
+      //! Remove all contacts.
+      void
+      clear(void)
+      {
+        m_cells.clear();
+      }
+
+      //! Add a contact.
+      //! @param[in] id contact identifier.
+      //! @param[in] x north coordinate (m).
+      //! @param[in] y east coordinate (m).
+      void
+      insert(unsigned id, double x, double y)
+      {
+        m_cells[getKey(x, y)].push_back(id);
+      }
+
+      //! Remove a contact.
+      //! @param[in] id contact identifier.
+      //! @param[in] x north coordinate where contact was inserted (m).
+      //! @param[in] y east coordinate where contact was inserted (m).
+      void
+      remove(unsigned id, double x, double y)
+      {
+        std::map<Key, std::vector<unsigned> >::iterator itr = m_cells.find(getKey(x, y));
+        if (itr == m_cells.end())
+          return;
+
+        std::vector<unsigned>& ids = itr->second;
+        ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+        if (ids.empty())
+          m_cells.erase(itr);
+      }
+
+      //! Move a contact. This is a no-op if the contact does not
+      //! change cell.
+      //! @param[in] id contact identifier.
+      //! @param[in] x0 previous north coordinate (m).
+      //! @param[in] y0 previous east coordinate (m).
+      //! @param[in] x1 new north coordinate (m).
+      //! @param[in] y1 new east coordinate (m).
+      void
+      move(unsigned id, double x0, double y0, double x1, double y1)
+      {
+        if (getKey(x0, y0) == getKey(x1, y1))
+          return;
+
+        remove(id, x0, y0);
+        insert(id, x1, y1);
+      }
+
+      //! Find the contacts in the cells overlapping a square
+      //! neighbourhood. Callers must check the actual distance.
+      //! @param[in] x north coordinate of the centre (m).
+      //! @param[in] y east coordinate of the centre (m).
+      //! @param[in] radius half side of the neighbourhood (m).
+      //! @param[out] ids contact identifiers.
+      void
+      query(double x, double y, double radius, std::vector<unsigned>& ids) const
+      {
+        ids.clear();
+
+        Key lo = getKey(x - radius, y - radius);
+        Key hi = getKey(x + radius, y + radius);
+        long cells = (hi.first - lo.first + 1) * (hi.second - lo.second + 1);
+
+        // Sparse pictures are cheaper to scan than large windows.
+        if (cells > (long)m_cells.size())
+        {
+          std::map<Key, std::vector<unsigned> >::const_iterator itr = m_cells.begin();
+          for (; itr != m_cells.end(); ++itr)
+          {
+            if (itr->first.first >= lo.first && itr->first.first <= hi.first
+                && itr->first.second >= lo.second && itr->first.second <= hi.second)
+              ids.insert(ids.end(), itr->second.begin(), itr->second.end());
+          }
+
+          return;
+        }
+
+        for (long i = lo.first; i <= hi.first; ++i)
+        {
+          for (long j = lo.second; j <= hi.second; ++j)
+          {
+            std::map<Key, std::vector<unsigned> >::const_iterator itr = m_cells.find(Key(i, j));
+            if (itr != m_cells.end())
+              ids.insert(ids.end(), itr->second.begin(), itr->second.end());
+          }
+        }
+      }
+
+    private:
+      //! Cell key.
+      typedef std::pair<long, long> Key;
+
+      //! Cell size (m).
+      double m_cell_size;
+      //! Occupied cells.
+      std::map<Key, std::vector<unsigned> > m_cells;
+
+      //! Get the key of the cell containing a point.
+      //! @param[in] x north coordinate (m).
+      //! @param[in] y east coordinate (m).
+      //! @return cell key.
+      Key
+      getKey(double x, double y) const
+      {
+        return Key((long)std::floor(x / m_cell_size), (long)std::floor(y / m_cell_size));
+      }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,810 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Index.hpp"
+
+namespace Monitors
+{
+  //! This task maintains a picture of the surface traffic around the
+  //! vehicle and evaluates the risk of collision with each contact.
+  //!
+  //! Contacts are reported by several sources: RemoteSensorInfo
+  //! messages (AIS receivers, Iridium relays) and Announce messages
+  //! of other IMC systems. Reports from different sources that fall
+  //! within an association gate of an existing contact are fused
+  //! into a single track, whose velocity is estimated with an
+  //! alpha-beta filter.
+  //!
+  //! Tracks are kept in a grid spatial index, so that only contacts
+  //! within the evaluation range of the vehicle are considered.
+  //! Closest point of approach (CPA) and time to CPA (TCPA) are
+  //! recomputed only for tracks whose geometry changed since the
+  //! last evaluation, or for all tracks in range when the motion of
+  //! the vehicle deviates from the one used in previous evaluations.
+  //!
+  //! A compact summary of the traffic picture is dispatched as an
+  //! Event with topic "Traffic", and the entity state is set to
+  //! fault while any contact is at risk.
+  //!
+  //! @author agent
+  namespace Traffic
+  {
+    using DUNE_NAMESPACES;
+
+    //! Position filter gain.
+    static const double c_alpha = 0.6;
+    //! Velocity filter gain.
+    static const double c_beta = 0.2;
+    //! Minimum interval between updates used to estimate velocity.
+    static const double c_min_dt = 0.5;
+    //! Distance from the reference that triggers a new reference.
+    static const double c_max_ref_distance = 20e3;
+
+    //! %Task arguments.
+    struct Arguments
+    {
+      //! Evaluation range.
+      double range;
+      //! CPA threshold.
+      double cpa_threshold;
+      //! TCPA horizon.
+      double tcpa_horizon;
+      //! Association gate.
+      double gate;
+      //! Contact timeout.
+      double timeout;
+      //! Own position tolerance.
+      double pos_tolerance;
+      //! Own velocity tolerance.
+      double vel_tolerance;
+      //! Spatial index cell size.
+      double cell_size;
+      //! Evaluation period.
+      double eval_period;
+      //! Report period.
+      double report_period;
+    };
+
+    //! Tracked contact.
+    struct Contact
+    {
+      //! Label.
+      std::string label;
+      //! Keys of the source reports fused in this contact.
+      std::vector<std::string> keys;
+      //! Kinds of the sources fused in this contact.
+      std::set<std::string> kinds;
+      //! North position at time of last update (m).
+      double x;
+      //! East position at time of last update (m).
+      double y;
+      //! North velocity (m/s).
+      double vx;
+      //! East velocity (m/s).
+      double vy;
+      //! Time of last update (s).
+      double time;
+      //! Number of updates.
+      unsigned updates;
+      //! North position used in the spatial index (m).
+      double ix;
+      //! East position used in the spatial index (m).
+      double iy;
+      //! True if the geometry changed since the last evaluation.
+      bool dirty;
+      //! True if the contact is within evaluation range.
+      bool in_range;
+      //! Closest point of approach (m).
+      double cpa;
+      //! Time of the closest point of approach (s).
+      double cpa_time;
+      //! Squared relative speed (m^2/s^2).
+      double speed2;
+      //! Range at the last evaluation (m).
+      double range;
+      //! Bearing at the last evaluation (rad).
+      double bearing;
+    };
+
+    //! Motion of the vehicle.
+    struct Motion
+    {
+      //! North position (m).
+      double x;
+      //! East position (m).
+      double y;
+      //! North velocity (m/s).
+      double vx;
+      //! East velocity (m/s).
+      double vy;
+      //! Time (s).
+      double time;
+    };
+
+    struct Task: public DUNE::Tasks::Task
+    {
+      //! Task arguments.
+      Arguments m_args;
+      //! Spatial index.
+      Index* m_index;
+      //! Contacts.
+      std::map<unsigned, Contact> m_contacts;
+      //! Contacts by source key.
+      std::map<std::string, unsigned> m_keys;
+      //! Contacts to evaluate.
+      std::set<unsigned> m_dirty;
+      //! Contacts within evaluation range.
+      std::set<unsigned> m_in_range;
+      //! Next contact identifier.
+      unsigned m_next_id;
+      //! Local frame reference latitude.
+      double m_ref_lat;
+      //! Local frame reference longitude.
+      double m_ref_lon;
+      //! True if the local frame reference is defined.
+      bool m_have_ref;
+      //! Current motion of the vehicle.
+      Motion m_own;
+      //! Motion of the vehicle used in the last full evaluation.
+      Motion m_own_eval;
+      //! True if the motion of the vehicle is known.
+      bool m_have_own;
+      //! True if all contacts in range must be evaluated.
+      bool m_own_dirty;
+      //! Number of contacts at risk in last report.
+      unsigned m_last_at_risk;
+      //! Most critical contact in last report.
+      std::string m_last_critical;
+      //! Evaluation timer.
+      Time::Counter<double> m_eval_timer;
+      //! Report timer.
+      Time::Counter<double> m_report_timer;
+      //! Neighbourhood query results.
+      std::vector<unsigned> m_query;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        DUNE::Tasks::Task(name, ctx),
+        m_index(NULL),
+        m_next_id(0),
+        m_ref_lat(0),
+        m_ref_lon(0),
+        m_have_ref(false),
+        m_have_own(false),
+        m_own_dirty(false),
+        m_last_at_risk(0)
+      {
+        param("Evaluation Range", m_args.range)
+        .defaultValue("3000")
+        .minimumValue("10")
+        .units(Units::Meter)
+        .description("Contacts beyond this range are not evaluated");
+
+        param("CPA Threshold", m_args.cpa_threshold)
+        .defaultValue("100")
+        .minimumValue("0")
+        .units(Units::Meter)
+        .description("Contacts passing closer than this distance are at risk");
+
+        param("TCPA Horizon", m_args.tcpa_horizon)
+        .defaultValue("600")
+        .minimumValue("0")
+        .units(Units::Second)
+        .description("Contacts reaching the closest point of approach later than this are not at risk");
+
+        param("Association Gate", m_args.gate)
+        .defaultValue("50")
+        .minimumValue("0")
+        .units(Units::Meter)
+        .description("Maximum distance to fuse reports of different sources into one contact");
+
+        param("Contact Timeout", m_args.timeout)
+        .defaultValue("180")
+        .minimumValue("1")
+        .units(Units::Second)
+        .description("Contacts without reports for this long are dropped");
+
+        param("Position Tolerance", m_args.pos_tolerance)
+        .defaultValue("10")
+        .minimumValue("0")
+        .units(Units::Meter)
+        .description("Deviation of the vehicle from its predicted position that triggers a full evaluation");
+
+        param("Velocity Tolerance", m_args.vel_tolerance)
+        .defaultValue("0.3")
+        .minimumValue("0")
+        .units(Units::MeterPerSecond)
+        .description("Change of the velocity of the vehicle that triggers a full evaluation");
+
+        param("Index Cell Size", m_args.cell_size)
+        .defaultValue("500")
+        .minimumValue("10")
+        .units(Units::Meter)
+        .description("Size of the cells of the contact spatial index");
+
+        param("Evaluation Period", m_args.eval_period)
+        .defaultValue("1")
+        .minimumValue("0.1")
+        .units(Units::Second)
+        .description("Period of the collision risk evaluation");
+
+        param("Report Period", m_args.report_period)
+        .defaultValue("10")
+        .minimumValue("0.1")
+        .units(Units::Second)
+        .description("Period of the traffic summary when no contact changes risk");
+
+        bind<IMC::Announce>(this);
+        bind<IMC::EstimatedState>(this, IMC::SourcePredicate::fromSystem(getSystemId()));
+        bind<IMC::RemoteSensorInfo>(this);
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        m_eval_timer.setTop(m_args.eval_period);
+        m_report_timer.setTop(m_args.report_period);
+
+        if (paramChanged(m_args.cell_size) && m_index != NULL)
+        {
+          Memory::clear(m_index);
+          m_index = new Index(m_args.cell_size);
+
+          std::map<unsigned, Contact>::iterator itr = m_contacts.begin();
+          for (; itr != m_contacts.end(); ++itr)
+            m_index->insert(itr->first, itr->second.ix, itr->second.iy);
+        }
+
+        m_own_dirty = true;
+      }
+
+      void
+      onResourceAcquisition(void)
+      {
+        m_index = new Index(m_args.cell_size);
+      }
+
+      void
+      onResourceInitialization(void)
+      {
+        setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        Memory::clear(m_index);
+        m_contacts.clear();
+        m_keys.clear();
+        m_dirty.clear();
+        m_in_range.clear();
+      }
+
+      void
+      consume(const IMC::Announce* msg)
+      {
+        if (msg->getSource() == getSystemId())
+          return;
+
+        if (msg->lat == 0 && msg->lon == 0)
+          return;
+
+        update("announce", msg->sys_name, msg->sys_name, msg->lat, msg->lon, getReportTime(msg));
+      }
+
+      void
+      consume(const IMC::EstimatedState* msg)
+      {
+        double lat = 0;
+        double lon = 0;
+        Coordinates::toWGS84(*msg, lat, lon);
+        setReference(lat, lon);
+
+        toLocal(lat, lon, m_own.x, m_own.y);
+        m_own.vx = msg->vx;
+        m_own.vy = msg->vy;
+        m_own.time = getReportTime(msg);
+
+        if (!m_have_own)
+        {
+          m_own_eval = m_own;
+          m_have_own = true;
+          m_own_dirty = true;
+          return;
+        }
+
+        // Compare with the motion used in the last full evaluation.
+        double dt = m_own.time - m_own_eval.time;
+        double ex = m_own_eval.x + m_own_eval.vx * dt - m_own.x;
+        double ey = m_own_eval.y + m_own_eval.vy * dt - m_own.y;
+        double dvx = m_own.vx - m_own_eval.vx;
+        double dvy = m_own.vy - m_own_eval.vy;
+
+        if (std::sqrt(ex * ex + ey * ey) > m_args.pos_tolerance
+            || std::sqrt(dvx * dvx + dvy * dvy) > m_args.vel_tolerance)
+          m_own_dirty = true;
+      }
+
+      void
+      consume(const IMC::RemoteSensorInfo* msg)
+      {
+        if (msg->id.empty())
+          return;
+
+        // Identifiers are only unique within a reporting entity.
+        std::string kind = String::str("rsi:%u:%u", msg->getSource(), msg->getSourceEntity());
+        update(kind, msg->id, msg->id, msg->lat, msg->lon, getReportTime(msg));
+      }
+
+      //! Get the time a report refers to. Reports relayed over slow
+      //! links can be minutes old, so their time stamp is used unless
+      //! it is missing or in the future.
+      //! @param[in] msg report.
+      //! @return report time (s).
+      double
+      getReportTime(const IMC::Message* msg) const
+      {
+        double now = Clock::getSinceEpoch();
+        double stamp = msg->getTimeStamp();
+        if (stamp <= 0 || stamp > now)
+          return now;
+
+        return stamp;
+      }
+
+      //! Define the local frame reference if undefined, or if the
+      //! given position is far from the current reference.
+      //! @param[in] lat latitude (rad).
+      //! @param[in] lon longitude (rad).
+      void
+      setReference(double lat, double lon)
+      {
+        if (m_have_ref)
+        {
+          double x = 0;
+          double y = 0;
+          toLocal(lat, lon, x, y);
+          if (std::sqrt(x * x + y * y) < c_max_ref_distance)
+            return;
+
+          // Move tracks and the vehicle to the new reference.
+          std::map<unsigned, Contact>::iterator itr = m_contacts.begin();
+          for (; itr != m_contacts.end(); ++itr)
+            rebase(itr->second.x, itr->second.y, lat, lon);
+
+          if (m_have_own)
+          {
+            rebase(m_own.x, m_own.y, lat, lon);
+            rebase(m_own_eval.x, m_own_eval.y, lat, lon);
+          }
+        }
+
+        m_ref_lat = lat;
+        m_ref_lon = lon;
+        m_have_ref = true;
+
+        m_index->clear();
+        std::map<unsigned, Contact>::iterator itr = m_contacts.begin();
+        for (; itr != m_contacts.end(); ++itr)
+        {
+          itr->second.ix = itr->second.x;
+          itr->second.iy = itr->second.y;
+          m_index->insert(itr->first, itr->second.ix, itr->second.iy);
+        }
+
+        m_own_dirty = true;
+      }
+
+      //! Convert local coordinates to a new reference.
+      //! @param[in,out] x north coordinate (m).
+      //! @param[in,out] y east coordinate (m).
+      //! @param[in] lat latitude of the new reference (rad).
+      //! @param[in] lon longitude of the new reference (rad).
+      void
+      rebase(double& x, double& y, double lat, double lon)
+      {
+        double plat = m_ref_lat;
+        double plon = m_ref_lon;
+        WGS84::displace(x, y, &plat, &plon);
+        WGS84::displacement(lat, lon, 0.0, plat, plon, 0.0, &x, &y);
+      }
+
+      //! Convert a position to the local frame.
+      //! @param[in] lat latitude (rad).
+      //! @param[in] lon longitude (rad).
+      //! @param[out] x north coordinate (m).
+      //! @param[out] y east coordinate (m).
+      void
+      toLocal(double lat, double lon, double& x, double& y) const
+      {
+        WGS84::displacement(m_ref_lat, m_ref_lon, 0.0, lat, lon, 0.0, &x, &y);
+      }
+
+      //! Find the contact nearest to a position, not yet fed by a
+      //! given kind of source, within the association gate.
+      //! @param[in] kind source kind.
+      //! @param[in] x north coordinate (m).
+      //! @param[in] y east coordinate (m).
+      //! @param[in] now current time (s).
+      //! @return contact identifier or UINT_MAX if none.
+      unsigned
+      associate(const std::string& kind, double x, double y, double now)
+      {
+        unsigned best = UINT_MAX;
+        double best_distance = m_args.gate;
+
+        m_index->query(x, y, m_args.gate, m_query);
+        for (size_t i = 0; i < m_query.size(); ++i)
+        {
+          Contact& c = m_contacts[m_query[i]];
+          if (c.kinds.find(kind) != c.kinds.end())
+            continue;
+
+          double dt = now - c.time;
+          double dx = c.x + c.vx * dt - x;
+          double dy = c.y + c.vy * dt - y;
+          double distance = std::sqrt(dx * dx + dy * dy);
+          if (distance <= best_distance)
+          {
+            best = m_query[i];
+            best_distance = distance;
+          }
+        }
+
+        return best;
+      }
+
+      //! Update a contact with a position report.
+      //! @param[in] kind source kind.
+      //! @param[in] id identifier of the contact within the source.
+      //! @param[in] label contact label.
+      //! @param[in] lat latitude (rad).
+      //! @param[in] lon longitude (rad).
+      //! @param[in] now time of the report (s).
+      void
+      update(const std::string& kind, const std::string& id, const std::string& label,
+             double lat, double lon, double now)
+      {
+        // Only the vehicle moves the reference, contacts far away are
+        // just converted to the local frame.
+        if (!m_have_ref)
+          setReference(lat, lon);
+
+        double x = 0;
+        double y = 0;
+        toLocal(lat, lon, x, y);
+
+        std::string key = kind + "/" + id;
+        unsigned cid = UINT_MAX;
+        std::map<std::string, unsigned>::iterator kitr = m_keys.find(key);
+        if (kitr != m_keys.end())
+          cid = kitr->second;
+        else
+          cid = associate(kind, x, y, now);
+
+        if (cid == UINT_MAX)
+        {
+          cid = m_next_id++;
+          Contact& c = m_contacts[cid];
+          c.label = label;
+          c.x = c.ix = x;
+          c.y = c.iy = y;
+          c.vx = c.vy = 0;
+          c.time = now;
+          c.updates = 1;
+          c.in_range = false;
+          c.cpa = c.range = c.bearing = 0;
+          c.cpa_time = now;
+          c.speed2 = 0;
+          m_index->insert(cid, x, y);
+          debug("new contact %s", label.c_str());
+        }
+        else
+        {
+          filter(m_contacts[cid], x, y, now);
+        }
+
+        Contact& c = m_contacts[cid];
+        if (kitr == m_keys.end())
+        {
+          m_keys[key] = cid;
+          c.keys.push_back(key);
+          c.kinds.insert(kind);
+          if (c.keys.size() > 1)
+            debug("fused %s into contact %s", key.c_str(), c.label.c_str());
+        }
+
+        m_index->move(cid, c.ix, c.iy, c.x, c.y);
+        c.ix = c.x;
+        c.iy = c.y;
+        c.dirty = true;
+        m_dirty.insert(cid);
+      }
+
+      //! Update the position and velocity of a contact.
+      //! @param[in,out] c contact.
+      //! @param[in] x measured north coordinate (m).
+      //! @param[in] y measured east coordinate (m).
+      //! @param[in] now time of the report (s).
+      void
+      filter(Contact& c, double x, double y, double now)
+      {
+        double dt = now - c.time;
+
+        // Reports older than the track, e.g. relayed by a slower link,
+        // carry no new information.
+        if (dt < 0)
+          return;
+
+        // Reports too close in time only refresh the position.
+        if (dt < c_min_dt)
+        {
+          c.x = x;
+          c.y = y;
+          return;
+        }
+
+        if (c.updates == 1)
+        {
+          c.vx = (x - c.x) / dt;
+          c.vy = (y - c.y) / dt;
+          c.x = x;
+          c.y = y;
+        }
+        else
+        {
+          double px = c.x + c.vx * dt;
+          double py = c.y + c.vy * dt;
+          double rx = x - px;
+          double ry = y - py;
+          c.x = px + c_alpha * rx;
+          c.y = py + c_alpha * ry;
+          c.vx += c_beta * rx / dt;
+          c.vy += c_beta * ry / dt;
+        }
+
+        c.time = now;
+        ++c.updates;
+      }
+
+      //! Remove contacts without recent reports.
+      //! @param[in] now current time (s).
+      void
+      expire(double now)
+      {
+        std::map<unsigned, Contact>::iterator itr = m_contacts.begin();
+        while (itr != m_contacts.end())
+        {
+          if (now - itr->second.time < m_args.timeout)
+          {
+            ++itr;
+            continue;
+          }
+
+          debug("dropped contact %s", itr->second.label.c_str());
+          for (size_t i = 0; i < itr->second.keys.size(); ++i)
+            m_keys.erase(itr->second.keys[i]);
+
+          m_index->remove(itr->first, itr->second.ix, itr->second.iy);
+          m_dirty.erase(itr->first);
+          m_in_range.erase(itr->first);
+          m_contacts.erase(itr++);
+        }
+      }
+
+      //! Compute the closest point of approach of a contact.
+      //! @param[in] cid contact identifier.
+      //! @param[in] now current time (s).
+      void
+      evaluate(unsigned cid, double now)
+      {
+        Contact& c = m_contacts[cid];
+        c.dirty = false;
+
+        double dto = now - m_own.time;
+        double dtc = now - c.time;
+        double rx = (c.x + c.vx * dtc) - (m_own.x + m_own.vx * dto);
+        double ry = (c.y + c.vy * dtc) - (m_own.y + m_own.vy * dto);
+
+        c.range = std::sqrt(rx * rx + ry * ry);
+        if (c.range > m_args.range)
+        {
+          c.in_range = false;
+          m_in_range.erase(cid);
+          return;
+        }
+
+        double vx = c.vx - m_own.vx;
+        double vy = c.vy - m_own.vy;
+        double v2 = vx * vx + vy * vy;
+        double tcpa = 0;
+        if (v2 > 1e-6)
+          tcpa = std::max(0.0, -(rx * vx + ry * vy) / v2);
+
+        double cx = rx + vx * tcpa;
+        double cy = ry + vy * tcpa;
+
+        c.cpa = std::sqrt(cx * cx + cy * cy);
+        c.cpa_time = now + tcpa;
+        c.speed2 = v2;
+        c.bearing = std::atan2(ry, rx);
+        c.in_range = true;
+        m_in_range.insert(cid);
+      }
+
+      //! Evaluate the contacts whose geometry changed. If the
+      //! vehicle deviated from its predicted motion, all contacts in
+      //! range are evaluated.
+      void
+      evaluate(void)
+      {
+        double now = Clock::getSinceEpoch();
+        expire(now);
+
+        if (!m_have_own)
+          return;
+
+        if (m_own_dirty)
+        {
+          double dt = now - m_own.time;
+          m_index->query(m_own.x + m_own.vx * dt, m_own.y + m_own.vy * dt,
+                         m_args.range, m_query);
+
+          std::set<unsigned> previous;
+          previous.swap(m_in_range);
+          for (size_t i = 0; i < m_query.size(); ++i)
+          {
+            evaluate(m_query[i], now);
+            previous.erase(m_query[i]);
+            m_dirty.erase(m_query[i]);
+          }
+
+          // Contacts that left the neighbourhood.
+          std::set<unsigned>::iterator itr = previous.begin();
+          for (; itr != previous.end(); ++itr)
+            m_contacts[*itr].in_range = false;
+
+          m_own_eval = m_own;
+          m_own_dirty = false;
+        }
+
+        std::set<unsigned>::iterator itr = m_dirty.begin();
+        for (; itr != m_dirty.end(); ++itr)
+          evaluate(*itr, now);
+
+        m_dirty.clear();
+      }
+
+      //! Test if a contact is at risk.
+      //! @param[in] c contact.
+      //! @param[in] now current time (s).
+      //! @return true if contact is at risk, false otherwise.
+      bool
+      atRisk(const Contact& c, double now) const
+      {
+        if (c.cpa >= m_args.cpa_threshold)
+          return false;
+
+        double tcpa = c.cpa_time - now;
+        if (tcpa >= 0)
+          return tcpa < m_args.tcpa_horizon;
+
+        // Past the closest point of approach: check current distance.
+        double d2 = c.cpa * c.cpa + c.speed2 * tcpa * tcpa;
+        return d2 < m_args.cpa_threshold * m_args.cpa_threshold;
+      }
+
+      //! Dispatch the traffic summary.
+      //! @param[in] force true to dispatch even if risk did not change.
+      void
+      report(bool force)
+      {
+        double now = Clock::getSinceEpoch();
+        unsigned at_risk = 0;
+        const Contact* critical = NULL;
+
+        std::set<unsigned>::iterator itr = m_in_range.begin();
+        for (; itr != m_in_range.end(); ++itr)
+        {
+          const Contact& c = m_contacts[*itr];
+          if (!atRisk(c, now))
+            continue;
+
+          ++at_risk;
+          if (critical == NULL || c.cpa_time < critical->cpa_time)
+            critical = &c;
+        }
+
+        std::string label = (critical == NULL) ? "" : critical->label;
+        if (!force && at_risk == m_last_at_risk && label == m_last_critical)
+          return;
+
+        m_last_at_risk = at_risk;
+        m_last_critical = label;
+        m_report_timer.reset();
+
+        IMC::Event event;
+        event.topic = "Traffic";
+        event.data = String::str("contacts=%u;in_range=%u;at_risk=%u",
+                                 (unsigned)m_contacts.size(), (unsigned)m_in_range.size(),
+                                 at_risk);
+
+        if (critical == NULL)
+        {
+          dispatch(event);
+          setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+          return;
+        }
+
+        double tcpa = std::max(0.0, critical->cpa_time - now);
+        event.data += String::str(";contact=%s;cpa=%0.1f;tcpa=%0.1f;range=%0.1f;bearing=%0.1f",
+                                  critical->label.c_str(), critical->cpa, tcpa,
+                                  critical->range, Angles::degrees(critical->bearing));
+        dispatch(event);
+
+        // Traffic is advisory: report the risk without a fault, which
+        // would drive the vehicle into error mode.
+        setEntityState(IMC::EntityState::ESTA_NORMAL,
+                       String::str(DTR("collision risk with %s: %0.0f m in %0.0f s"),
+                                   critical->label.c_str(), critical->cpa, tcpa));
+      }
+
+      void
+      onMain(void)
+      {
+        while (!stopping())
+        {
+          waitForMessages(std::min(m_eval_timer.getRemaining(), m_report_timer.getRemaining()));
+
+          if (m_eval_timer.overflow())
+          {
+            m_eval_timer.reset();
+            evaluate();
+            report(false);
+          }
+
+          if (m_report_timer.overflow())
+            report(true);
+        }
+      }
+    };
+  }
+}
+
+DUNE_TASK
@@ -464,7 +464,7 @@ namespace Navigation
         {
           while (!stopping())
           {
-            waitForMessages(1.0);
+            waitForMessages();
           }
         }
       };
@@ -620,7 +620,7 @@ namespace Plan
       {
         while (!stopping())
         {
-          waitForMessages(1.0);
+          waitForMessages();
         }
       }
     };
@@ -27,6 +27,10 @@
 // Author: Pedro Calado                                                     *
 //***************************************************************************
 
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <limits>
+
 // Local headers
 #include "ActionSchedule.hpp"
 
@@ -37,9 +41,12 @@ namespace Plan
     ActionSchedule::ActionSchedule(Tasks::Task* task, const IMC::PlanSpecification* spec,
                                    const std::vector<IMC::PlanManeuver*>& nodes,
                                    const Timeline& tline,
-                                   const std::map<std::string, IMC::EntityInfo>& cinfo):
+                                   const std::map<std::string, IMC::EntityInfo>& cinfo,
+                                   const Power::Model* power, float power_budget):
       m_task(task),
-      m_cinfo(&cinfo)
+      m_cinfo(&cinfo),
+      m_power(power),
+      m_power_budget(power_budget)
     {
       // Set execution duration
       m_execution_duration = tline.getExecutionDuration();
@@ -69,6 +76,9 @@ namespace Plan
       // Create a proper schedule from the unscheduled set of actions
       scheduleTimed();
 
+      // Stagger activations that would exceed the power budget
+      budgetActivations();
+
       std::map<std::string, TimedStack>::const_iterator next;
       next = nextSchedule();
 
@@ -82,7 +92,9 @@ namespace Plan
                                    const std::vector<IMC::PlanManeuver*>& nodes,
                                    const std::map<std::string, IMC::EntityInfo>& cinfo):
       m_task(task),
-      m_cinfo(&cinfo)
+      m_cinfo(&cinfo),
+      m_power(NULL),
+      m_power_budget(0.0)
     {
       m_execution_duration = -1.0;
 
@@ -703,6 +715,148 @@ namespace Plan
       }
     }
 
+    void
+    ActionSchedule::budgetActivations(void)
+    {
+      if (m_power == NULL || m_power_budget <= 0.0 || m_timed.empty())
+        return;
+
+      //! Activation window of a payload, in time left to the end of plan.
+      struct Window
+      {
+        //! Pointer to the scheduled action.
+        TimedAction* action;
+        //! Power drawn by the payload.
+        float power;
+        //! Duration of the activation.
+        float duration;
+        //! Latest time at which the activation may start.
+        float limit;
+
+        float
+        start(void) const
+        {
+          return action->sched_time;
+        }
+
+        float
+        end(void) const
+        {
+          return action->sched_time - duration;
+        }
+
+        //! Sort by the latest end first.
+        bool
+        operator<(const Window& other) const
+        {
+          return end() < other.end();
+        }
+      };
+
+      // Unstack actions, first ones to be fired first.
+      std::map<std::string, std::vector<TimedAction> > actions;
+      std::map<std::string, TimedStack>::iterator itr = m_timed.begin();
+      for (; itr != m_timed.end(); ++itr)
+      {
+        std::vector<TimedAction>& vec = actions[itr->first];
+        for (; !itr->second.empty(); itr->second.pop())
+          vec.push_back(itr->second.top());
+      }
+
+      std::vector<Window> windows;
+      std::map<std::string, std::vector<TimedAction> >::iterator aitr = actions.begin();
+      for (; aitr != actions.end(); ++aitr)
+      {
+        float power = m_power->getPayloadPower(aitr->first);
+        if (power <= 0.0)
+          continue;
+
+        std::vector<TimedAction>& vec = aitr->second;
+        for (size_t i = 0; i < vec.size(); ++i)
+        {
+          if (vec[i].type != TYPE_ACT || !vec[i].prescheduled)
+            continue;
+
+          Window w;
+          w.action = &vec[i];
+          w.power = power;
+          w.duration = getActivationTime(aitr->first);
+          // Never move an activation before the previous deactivation.
+          if (i == 0)
+            w.limit = std::numeric_limits<float>::max();
+          else
+            w.limit = vec[i - 1].sched_time - getDeactivationTime(aitr->first);
+
+          windows.push_back(w);
+        }
+      }
+
+      // Place the activations needed last first, moving each one
+      // forward until the power drawn by all activations being
+      // performed at the same time fits the budget.
+      std::sort(windows.begin(), windows.end());
+
+      for (size_t i = 0; i < windows.size(); ++i)
+      {
+        Window& w = windows[i];
+        float original = w.start();
+
+        while (true)
+        {
+          // Peak load happens when some activation starts.
+          float peak = 0.0;
+          float earliest_start = std::numeric_limits<float>::max();
+
+          for (size_t j = 0; j < i; ++j)
+          {
+            if (windows[j].start() <= w.end() || windows[j].end() >= w.start())
+              continue;
+
+            earliest_start = std::min(earliest_start, windows[j].start());
+
+            float t = std::min(windows[j].start(), w.start());
+            float load = 0.0;
+            for (size_t k = 0; k < i; ++k)
+            {
+              if (windows[k].start() >= t && windows[k].end() < t)
+                load += windows[k].power;
+            }
+
+            peak = std::max(peak, load);
+          }
+
+          // Nothing to gain if no other activation is in the way.
+          if (peak + w.power <= m_power_budget ||
+              earliest_start == std::numeric_limits<float>::max())
+            break;
+
+          // Finish when the conflicting activation closest to the end starts.
+          float start = earliest_start + w.duration;
+          if (start > w.limit)
+          {
+            m_task->war(DTR("schedule: activation of %s exceeds power budget"),
+                        w.action->list->name.c_str());
+            break;
+          }
+
+          w.action->sched_time = start;
+        }
+
+        if (w.start() != original)
+          m_task->debug("schedule: %s activation brought forward by %.1f s",
+                        w.action->list->name.c_str(), w.start() - original);
+      }
+
+      // Restack actions.
+      for (aitr = actions.begin(); aitr != actions.end(); ++aitr)
+      {
+        std::vector<TimedAction>& vec = aitr->second;
+        TimedStack& stack = m_timed[aitr->first];
+        for (size_t i = vec.size(); i > 0; --i)
+          stack.push(vec[i - 1]);
+      }
+    }
+
     std::map<std::string, ActionSchedule::TimedStack>::iterator
     ActionSchedule::nextSchedule(void)
     {
@@ -41,6 +41,7 @@
 // DUNE headers.
 #include <DUNE/Plans.hpp>
 #include <DUNE/IMC.hpp>
+#include <DUNE/Power/Model.hpp>
 #include "Calibration.hpp"
 #include "Timeline.hpp"
 #include "ComponentActiveTime.hpp"
@@ -65,11 +66,16 @@ namespace Plan
       //! @param[in] nodes vector of sequential PlanManeuvers that describe the plan
       //! @param[in] tline plan timeline with maneuvers' and plan's ETAs
       //! @param[in] cinfo map of components info
+      //! @param[in] power pointer to power model with the payloads' consumption
+      //! @param[in] power_budget power available to payloads being
+      //! activated simultaneously in W (0 for no limit)
       ActionSchedule(Tasks::Task* task,
                      const IMC::PlanSpecification* spec,
                      const std::vector<IMC::PlanManeuver*>& nodes,
                      const Timeline& tline,
-                     const std::map<std::string, IMC::EntityInfo>& cinfo);
+                     const std::map<std::string, IMC::EntityInfo>& cinfo,
+                     const Power::Model* power = NULL,
+                     float power_budget = 0.0);
 
       //! Alternative constructor for when plan is not sequential.
       //! There will be no pre-scheduling using this constructor.
@@ -278,6 +284,11 @@ namespace Plan
       void
       scheduleTimed(void);
 
+      //! Bring pre-scheduled activations forward so that payloads
+      //! being activated at the same time stay within the power budget
+      void
+      budgetActivations(void);
+
       //! Dispatch actions
       //! @param[in] msg SetEntityParameters to dispatch
       void
@@ -327,6 +338,10 @@ namespace Plan
       std::map<std::string, TimedAction> m_reqs;
       //! Expected plan duration disregarding calibration time
       float m_execution_duration;
+      //! Pointer to power model with the payloads' consumption
+      const Power::Model* m_power;
+      //! Power available to payloads being activated simultaneously
+      float m_power_budget;
     };
   }
 }
@@ -39,7 +39,8 @@ namespace Plan
   {
     Plan::Plan(const IMC::PlanSpecification* spec, bool compute_progress,
                bool fpredict, float max_depth, Tasks::Task* task,
-               uint16_t min_cal_time, Parsers::Config* cfg):
+               uint16_t min_cal_time, float act_power_budget,
+               Parsers::Config* cfg):
       m_spec(spec),
       m_curr_node(NULL),
       m_compute_progress(compute_progress),
@@ -53,6 +54,7 @@ namespace Plan
       m_started_maneuver(false),
       m_calib(NULL),
       m_min_cal_time(min_cal_time),
+      m_act_power_budget(act_power_budget),
       m_config(cfg),
       m_fpred(NULL),
       m_task(task),
@@ -471,7 +473,8 @@ namespace Plan
 
           Memory::clear(m_sched);
           m_sched = new ActionSchedule(m_task, m_spec, m_seq_nodes,
-                                       tline, cinfo);
+                                       tline, cinfo, m_power_model,
+                                       m_act_power_budget);
 
           // Update timeline with scheduled calibration time if any
           tline.setPlanETA(std::max(m_sched->getEarliestSchedule(), getExecutionDuration()));
@@ -74,10 +74,13 @@ namespace Plan
       //! @param[in] max_depth maximum admissible depth
       //! @param[in] task pointer to task
       //! @param[in] min_cal_time minimum calibration time in s.
+      //! @param[in] act_power_budget power available to payloads
+      //! being activated simultaneously in W (0 for no limit).
       //! @param[in] cfg pointer to config object
       Plan(const IMC::PlanSpecification* spec, bool compute_progress,
            bool fpredict, float max_depth, Tasks::Task* task,
-           uint16_t min_cal_time, Parsers::Config* cfg);
+           uint16_t min_cal_time, float act_power_budget,
+           Parsers::Config* cfg);
 
       //! Destructor
       ~Plan(void);
@@ -348,6 +351,8 @@ namespace Plan
       Calibration* m_calib;
       //! Minimum calibration time
       uint16_t m_min_cal_time;
+      //! Power available to payloads being activated simultaneously
+      float m_act_power_budget;
       //! Component active time for fuel estimation
       ComponentActiveTime m_cat;
       //! Pointer to speed model for speed conversions
@@ -89,6 +89,8 @@ namespace Plan
       std::string label_gen;
       //! Absolute maximum depth.
       float max_depth;
+      //! Power available to payloads being activated simultaneously.
+      float act_power_budget;
     };
 
     struct Task: public DUNE::Tasks::Task
@@ -176,6 +178,14 @@ namespace Plan
         .units(Units::Meter)
         .description("Radius for the station keeping");
 
+        param("Activation Power Budget", m_args.act_power_budget)
+        .defaultValue("0")
+        .units(Units::Watt)
+        .minimumValue("0")
+        .description("Maximum power drawn by payloads that are being activated "
+                     "at the same time, activations are brought forward to stay "
+                     "within this budget. Zero means no limit");
+
         param("IMU Entity Label", m_args.label_imu)
         .defaultValue("IMU")
         .description("Entity label of the IMU for fuel prediction");
@@ -229,7 +239,8 @@ namespace Plan
           m_args.speriod = 1.0 / m_args.speriod;
 
         if ((m_plan != NULL) && (paramChanged(m_args.progress) ||
-                                 paramChanged(m_args.calibration_time)))
+                                 paramChanged(m_args.calibration_time) ||
+                                 paramChanged(m_args.act_power_budget)))
           throw RestartNeeded(DTR("restarting to relaunch plan parser"), 0, false);
       }
 
@@ -243,7 +254,8 @@ namespace Plan
       onResourceAcquisition(void)
       {
         m_plan = new Plan(&m_spec, m_args.progress, m_args.fpredict, m_args.max_depth,
-                          this, m_args.calibration_time, &m_ctx.config);
+                          this, m_args.calibration_time, m_args.act_power_budget,
+                          &m_ctx.config);
       }
 
       void
@@ -281,7 +293,11 @@ namespace Plan
       void
       consume(const IMC::EntityInfo* msg)
       {
-        m_cinfo.insert(std::pair<std::string, IMC::EntityInfo>(msg->label, *msg));
+        if (msg->getSource() != getSystemId())
+          return;
+
+        // Entities may update their activation times at runtime.
+        m_cinfo[msg->label] = *msg;
       }
 
       void
@@ -289,7 +289,7 @@ namespace Plan
 
         while (!stopping())
         {
-          waitForMessages(1.0);
+          waitForMessages();
         }
       }
 
@@ -313,7 +313,7 @@ namespace Sensors
       {
         while (!stopping())
         {
-          waitForMessages(1.0);
+          waitForMessages();
         }
       }
     };
@@ -290,7 +290,7 @@ namespace Sensors
           try
           {
             rv = m_uart->read(m_buffer, sizeof(m_buffer));
-            m_tstamp = Clock::getSinceEpoch();
+            m_tstamp = m_uart->getLastReadTime();
           }
           catch (std::exception& e)
           {
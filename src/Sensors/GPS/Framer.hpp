@@ -0,0 +1,191 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef SENSORS_GPS_FRAMER_HPP_INCLUDED_
+#define SENSORS_GPS_FRAMER_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <deque>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Sensors
+{
+  namespace GPS
+  {
+    using DUNE_NAMESPACES;
+
+    //! Base of binary framers whose frames start with two
+    //! synchronization bytes followed by a fixed size header that
+    //! gives the frame size. When a frame turns out to be invalid,
+    //! its bytes after the first one are parsed again, since a valid
+    //! frame may start among them. Parsing stops at every complete
+    //! frame, and bytes not parsed yet are kept for the next call.
+    class Framer
+    {
+    public:
+      //! Constructor.
+      //! @param[in] sync0 first synchronization byte.
+      //! @param[in] sync1 second synchronization byte.
+      //! @param[in] header_size size of the header, synchronization
+      //! bytes included.
+      Framer(uint8_t sync0, uint8_t sync1, size_t header_size):
+        m_size(0),
+        m_sync0(sync0),
+        m_sync1(sync1),
+        m_header_size(header_size),
+        m_complete(false)
+      { }
+
+      virtual
+      ~Framer(void)
+      { }
+
+      //! Discard any partial frame and pending bytes.
+      void
+      reset(void)
+      {
+        m_frame.clear();
+        m_pending.clear();
+        m_complete = false;
+      }
+
+      //! Parse one byte, along with any bytes left pending by a
+      //! previous call.
+      //! @param[in] byte input byte.
+      //! @return true when a valid frame is complete.
+      bool
+      parse(uint8_t byte)
+      {
+        m_pending.push_back(byte);
+
+        while (!m_pending.empty())
+        {
+          uint8_t next = m_pending.front();
+          m_pending.pop_front();
+
+          if (step(next))
+            return true;
+        }
+
+        return false;
+      }
+
+    protected:
+      //! Current frame.
+      std::vector<uint8_t> m_frame;
+      //! Expected frame size.
+      size_t m_size;
+
+      //! Compute the size of the current frame from its header.
+      //! @return frame size or zero if the header is invalid.
+      virtual size_t
+      getFrameSize(void) const = 0;
+
+      //! Check the integrity of the current frame.
+      //! @return true if the frame is valid, false otherwise.
+      virtual bool
+      isValid(void) const = 0;
+
+    private:
+      //! Bytes waiting to be parsed.
+      std::deque<uint8_t> m_pending;
+      //! First synchronization byte.
+      uint8_t m_sync0;
+      //! Second synchronization byte.
+      uint8_t m_sync1;
+      //! Header size.
+      size_t m_header_size;
+      //! True if the current frame is complete.
+      bool m_complete;
+
+      //! Add one byte to the current frame.
+      //! @param[in] byte input byte.
+      //! @return true when a valid frame is complete.
+      bool
+      step(uint8_t byte)
+      {
+        if (m_complete)
+        {
+          m_frame.clear();
+          m_complete = false;
+        }
+
+        if (m_frame.empty())
+        {
+          if (byte == m_sync0)
+            m_frame.push_back(byte);
+          return false;
+        }
+
+        if (m_frame.size() == 1)
+        {
+          if (byte == m_sync1)
+            m_frame.push_back(byte);
+          else if (byte != m_sync0)
+            m_frame.clear();
+          return false;
+        }
+
+        m_frame.push_back(byte);
+
+        if (m_frame.size() == m_header_size)
+        {
+          m_size = getFrameSize();
+          if (m_size == 0)
+            return resync();
+        }
+
+        if (m_frame.size() < m_header_size || m_frame.size() < m_size)
+          return false;
+
+        if (!isValid())
+          return resync();
+
+        m_complete = true;
+        return true;
+      }
+
+      //! Discard the first byte of an invalid frame and queue the
+      //! remaining ones to be parsed again.
+      //! @return false.
+      bool
+      resync(void)
+      {
+        m_pending.insert(m_pending.begin(), m_frame.begin() + 1, m_frame.end());
+        m_frame.clear();
+        return false;
+      }
+    };
+  }
+}
+
+#endif
@@ -50,9 +50,11 @@ namespace Sensors
       //! Constructor.
       //! @param[in] task parent task.
       //! @param[in] handle I/O handle.
-      Reader(Tasks::Task* task, IO::Handle* handle):
+      //! @param[in] binary true to forward raw data instead of lines.
+      Reader(Tasks::Task* task, IO::Handle* handle, bool binary = false):
         m_task(task),
-        m_handle(handle)
+        m_handle(handle),
+        m_binary(binary)
       {
         m_buffer.resize(c_read_buffer_size);
       }
@@ -62,17 +64,19 @@ namespace Sensors
       Tasks::Task* m_task;
       //! I/O handle.
       IO::Handle* m_handle;
+      //! True if raw data is forwarded instead of lines.
+      bool m_binary;
       //! Internal read buffer.
       std::vector<char> m_buffer;
       //! Current line.
       std::string m_line;
 
       void
-      dispatch(IMC::Message& msg)
+      dispatch(IMC::Message& msg, unsigned int flags = 0)
       {
         msg.setDestination(m_task->getSystemId());
         msg.setDestinationEntity(m_task->getEntityId());
-        m_task->dispatch(msg, DF_LOOP_BACK);
+        m_task->dispatch(msg, DF_LOOP_BACK | flags);
       }
 
       void
@@ -85,6 +89,26 @@ namespace Sensors
         if (rv == 0)
           throw std::runtime_error(DTR("invalid read size"));
 
+        if (m_binary)
+        {
+          IMC::DevDataBinary data;
+          data.value.assign(m_buffer.begin(), m_buffer.begin() + rv);
+
+          // Stamp data with its arrival time when the handle knows it.
+          double time = m_handle->getLastReadTime();
+          if (time > 0)
+          {
+            data.setTimeStamp(time);
+            dispatch(data, DF_KEEP_TIME);
+          }
+          else
+          {
+            dispatch(data);
+          }
+
+          return;
+        }
+
         for (size_t i = 0; i < rv; ++i)
         {
           m_line.push_back(m_buffer[i]);
@@ -0,0 +1,130 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef SENSORS_GPS_SBF_HPP_INCLUDED_
+#define SENSORS_GPS_SBF_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Framer.hpp"
+
+namespace Sensors
+{
+  namespace GPS
+  {
+    using DUNE_NAMESPACES;
+
+    //! Framer of Septentrio Binary Format (SBF) blocks. A block
+    //! starts with the synchronization bytes '$@', followed by a
+    //! CRC-16-CCITT, the block identifier and the little-endian block
+    //! length (header included, multiple of four). The CRC covers
+    //! everything from the identifier to the end of the block.
+    class SBF: public Framer
+    {
+    public:
+      //! Position, velocity and time in geodetic coordinates.
+      static const uint16_t c_pvt_geodetic = 4007;
+      //! Dilution of precision.
+      static const uint16_t c_dop = 4001;
+      //! Attitude from multi-antenna receivers.
+      static const uint16_t c_att_euler = 5938;
+      //! Receiver time and leap seconds.
+      static const uint16_t c_receiver_time = 5914;
+      //! Size of the block header.
+      static const size_t c_header_size = 8;
+      //! Maximum block size.
+      static const size_t c_max_size = 16384;
+
+      SBF(void):
+        Framer('$', '@', c_header_size)
+      { }
+
+      //! Retrieve the block number of the last block (revision
+      //! excluded).
+      uint16_t
+      getId(void) const
+      {
+        return (m_frame[4] | (m_frame[5] << 8)) & 0x1fff;
+      }
+
+      //! Retrieve the last block, including the header. Field offsets
+      //! in the SBF reference guide are relative to the start of the
+      //! block.
+      const std::vector<uint8_t>&
+      getBlock(void) const
+      {
+        return m_frame;
+      }
+
+    private:
+      size_t
+      getFrameSize(void) const
+      {
+        size_t size = m_frame[6] | (m_frame[7] << 8);
+        if (size < c_header_size || size > c_max_size || (size % 4) != 0)
+          return 0;
+
+        return size;
+      }
+
+      bool
+      isValid(void) const
+      {
+        uint16_t crc = m_frame[2] | (m_frame[3] << 8);
+        return computeCRC(&m_frame[4], m_size - 4) == crc;
+      }
+
+      //! Compute the CRC-16-CCITT (polynomial 0x1021, zero initial
+      //! value) of a buffer.
+      //! @param[in] data buffer.
+      //! @param[in] size buffer size.
+      //! @return CRC.
+      static uint16_t
+      computeCRC(const uint8_t* data, size_t size)
+      {
+        uint16_t crc = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+          crc ^= (uint16_t)data[i] << 8;
+          for (unsigned j = 0; j < 8; ++j)
+            crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+        }
+
+        return crc;
+      }
+    };
+  }
+}
+
+#endif
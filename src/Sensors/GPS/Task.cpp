@@ -29,18 +29,23 @@
 
 // ISO C++ 98 headers.
 #include <cstring>
+#include <cmath>
 #include <algorithm>
 #include <cstddef>
+#include <fstream>
 
 // DUNE headers.
 #include <DUNE/DUNE.hpp>
 
 // Local headers.
 #include "Reader.hpp"
+#include "UBX.hpp"
+#include "SBF.hpp"
 
 namespace Sensors
 {
-  //! Device driver for NMEA capable %GPS devices.
+  //! Device driver for NMEA, u-blox UBX and Septentrio SBF capable
+  //! %GPS devices.
   namespace GPS
   {
     using DUNE_NAMESPACES;
@@ -49,6 +54,8 @@ namespace Sensors
     static const unsigned c_max_init_cmds = 14;
     //! Timeout for waitReply() function.
     static const float c_wait_reply_tout = 4.0;
+    //! Maximum amount of binary data kept while waiting for a reply.
+    static const size_t c_max_init_data = 4096;
     //! Minimum number of fields of PUBX,00 sentence.
     static const unsigned c_pubx00_fields = 21;
     //! Minimum number of fields of GGA sentence.
@@ -67,6 +74,35 @@ namespace Sensors
     static const unsigned c_psathpr_fields = 7;
     //! Power on delay.
     static const double c_pwr_on_delay = 5.0;
+    //! Unix time of the GPS time origin (1980-01-06).
+    static const double c_gps_epoch = 315964800.0;
+    //! Seconds in a GPS week.
+    static const double c_gps_week = 604800.0;
+    //! Default difference between GPS time and UTC.
+    static const int c_gps_leap_seconds = 18;
+    //! Maximum age of dilution of precision values (ms).
+    static const uint32_t c_dop_max_age = 1000;
+    //! SBF do-not-use value of floating point fields.
+    static const double c_sbf_dnu = -2e10;
+    //! SBF blocks holding raw observations or navigation bits.
+    static const uint16_t c_sbf_raw[] =
+    {
+      // MeasExtra, GPSRawCA, GPSRawL2C, GPSRawL5, GALRawFNAV, GALRawINAV.
+      4000, 4017, 4018, 4019, 4022, 4023,
+      // GALRawCNAV, GLORawCA, MeasEpoch, BDSRaw, Meas3Ranges.
+      4024, 4026, 4027, 4047, 4109
+    };
+
+    //! Receiver output protocols.
+    enum Protocol
+    {
+      //! NMEA sentences.
+      PROTO_NMEA,
+      //! u-blox UBX messages.
+      PROTO_UBX,
+      //! Septentrio SBF blocks.
+      PROTO_SBF
+    };
 
     struct Arguments
     {
@@ -84,6 +120,10 @@ namespace Sensors
       std::string init_rpls[c_max_init_cmds];
       //! Power channels.
       std::vector<std::string> pwr_channels;
+      //! Output protocol.
+      std::string protocol;
+      //! Log raw observations.
+      bool raw_log;
     };
 
     struct Task: public Tasks::Task
@@ -106,17 +146,42 @@ namespace Sensors
       bool m_has_euler;
       //! Last initialization line read.
       std::string m_init_line;
+      //! Binary data read while waiting for a reply.
+      std::string m_init_data;
       //! Reader thread.
       Reader* m_reader;
       //! Buffer forEntityState
       char m_bufer_entity[64];
+      //! Output protocol.
+      Protocol m_proto;
+      //! UBX framer.
+      UBX m_ubx;
+      //! SBF framer.
+      SBF m_sbf;
+      //! Difference between GPS time and UTC.
+      int m_leap_seconds;
+      //! Time of week of the last dilution of precision values (ms).
+      uint32_t m_dop_tow;
+      //! Horizontal dilution of precision.
+      float m_hdop;
+      //! Vertical dilution of precision.
+      float m_vdop;
+      //! Raw observations log file.
+      std::ofstream m_raw_file;
+      //! Raw observations log path.
+      Path m_raw_path;
 
       Task(const std::string& name, Tasks::Context& ctx):
         Tasks::Task(name, ctx),
         m_handle(NULL),
         m_has_agvel(false),
         m_has_euler(false),
-        m_reader(NULL)
+        m_reader(NULL),
+        m_proto(PROTO_NMEA),
+        m_leap_seconds(c_gps_leap_seconds),
+        m_dop_tow(0),
+        m_hdop(0),
+        m_vdop(0)
       {
         // Define configuration parameters.
         param("Serial Port - Device", m_args.uart_dev)
@@ -141,6 +206,17 @@ namespace Sensors
         .defaultValue("")
         .description("Sentence order");
 
+        param("Protocol", m_args.protocol)
+        .defaultValue("NMEA")
+        .values("NMEA, UBX, SBF")
+        .description("Output protocol of the receiver. UBX and SBF deliver"
+                     " every navigation epoch as soon as it is received");
+
+        param("Raw Observations - Log", m_args.raw_log)
+        .defaultValue("false")
+        .description("Store raw observations received with UBX or SBF in"
+                     " the current log folder, for post-processing");
+
         for (unsigned i = 0; i < c_max_init_cmds; ++i)
         {
           std::string cmd_label = String::str("Initialization String %u - Command", i);
@@ -156,7 +232,20 @@ namespace Sensors
         clearMessages();
 
         bind<IMC::DevDataText>(this);
+        bind<IMC::DevDataBinary>(this);
         bind<IMC::IoEvent>(this);
+        bind<IMC::LoggingControl>(this);
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        if (m_args.protocol == "UBX")
+          m_proto = PROTO_UBX;
+        else if (m_args.protocol == "SBF")
+          m_proto = PROTO_SBF;
+        else
+          m_proto = PROTO_NMEA;
       }
 
       void
@@ -182,7 +271,7 @@ namespace Sensors
           if (!openSocket())
             m_handle = new SerialPort(m_args.uart_dev, m_args.uart_baud);
 
-          m_reader = new Reader(this, m_handle);
+          m_reader = new Reader(this, m_handle, m_proto != PROTO_NMEA);
           m_reader->start();
         }
         catch (...)
@@ -217,6 +306,9 @@ namespace Sensors
         }
 
         Memory::clear(m_handle);
+        closeRawLog();
+        m_ubx.reset();
+        m_sbf.reset();
       }
 
       void
@@ -228,6 +320,7 @@ namespace Sensors
             continue;
 
           std::string cmd = String::unescape(m_args.init_cmds[i]);
+          m_init_data.clear();
           m_handle->writeString(cmd.c_str());
 
           if (!m_args.init_rpls[i].empty())
@@ -243,6 +336,13 @@ namespace Sensors
 
         setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
         m_wdog.setTop(m_args.inp_tout);
+
+        if (m_args.raw_log && m_proto != PROTO_NMEA)
+        {
+          IMC::LoggingControl lc;
+          lc.op = IMC::LoggingControl::COP_REQUEST_CURRENT_NAME;
+          dispatch(lc);
+        }
       }
 
       void
@@ -262,6 +362,68 @@ namespace Sensors
           processSentence(msg->value);
       }
 
+      void
+      consume(const IMC::DevDataBinary* msg)
+      {
+        if (msg->getDestination() != getSystemId())
+          return;
+
+        if (msg->getDestinationEntity() != getEntityId())
+          return;
+
+        // Replies to initialization commands arrive within the binary
+        // stream (e.g., the ASCII replies of SBF receivers).
+        if (getEntityState() == IMC::EntityState::ESTA_BOOT)
+        {
+          m_init_data.append(msg->value.begin(), msg->value.end());
+          if (m_init_data.size() > c_max_init_data)
+            m_init_data.erase(0, m_init_data.size() - c_max_init_data);
+          return;
+        }
+
+        double time = msg->getTimeStamp();
+        const std::vector<char>& data = msg->value;
+
+        if (m_proto == PROTO_UBX)
+        {
+          for (size_t i = 0; i < data.size(); ++i)
+          {
+            if (m_ubx.parse(data[i]))
+              interpretUBX(time);
+          }
+        }
+        else if (m_proto == PROTO_SBF)
+        {
+          for (size_t i = 0; i < data.size(); ++i)
+          {
+            if (m_sbf.parse(data[i]))
+              interpretSBF(time);
+          }
+        }
+      }
+
+      void
+      consume(const IMC::LoggingControl* msg)
+      {
+        if (msg->getSource() != getSystemId())
+          return;
+
+        if (!m_args.raw_log || m_proto == PROTO_NMEA)
+          return;
+
+        switch (msg->op)
+        {
+          case IMC::LoggingControl::COP_STARTED:
+          case IMC::LoggingControl::COP_CURRENT_NAME:
+            openRawLog(m_ctx.dir_log / msg->name / String::str("GNSS.%s", m_proto == PROTO_UBX ? "ubx" : "sbf"));
+            break;
+
+          case IMC::LoggingControl::COP_STOPPED:
+            closeRawLog();
+            break;
+        }
+      }
+
       void
       consume(const IMC::IoEvent* msg)
       {
@@ -283,7 +445,9 @@ namespace Sensors
         m_fix.clear();
       }
 
-      //! Wait reply to initialization command.
+      //! Wait reply to initialization command. With NMEA the reply
+      //! must match a whole line, with binary protocols it may be
+      //! anywhere in the data received since the command was sent.
       //! @param[in] stn string to compare.
       //! @return true on successful match, false otherwise.
       bool
@@ -293,9 +457,17 @@ namespace Sensors
         while (!stopping() && !counter.overflow())
         {
           waitForMessages(counter.getRemaining());
-          if (m_init_line == stn)
+
+          bool match = false;
+          if (m_proto == PROTO_NMEA)
+            match = (m_init_line == stn);
+          else
+            match = (m_init_data.find(stn) != std::string::npos);
+
+          if (match)
           {
             m_init_line.clear();
+            m_init_data.clear();
             return true;
           }
         }
@@ -513,17 +685,24 @@ namespace Sensors
             m_has_agvel = false;
           }
 
-          std::memset(&m_bufer_entity, '\0', sizeof(m_bufer_entity));
-          if (m_fix.validity & IMC::GpsFix::GFV_VALID_POS)
-          {
-            std::sprintf(m_bufer_entity, "active - hdop: %.2f , Sat: %d", m_fix.hdop, m_fix.satellites);
-            setEntityState(IMC::EntityState::ESTA_NORMAL, Utils::String::str(DTR(m_bufer_entity)));
-          }
-          else
-          {
-            std::sprintf(m_bufer_entity, "wait gps fix - hdop: %.2f , Sat: %d", m_fix.hdop, m_fix.satellites);
-            setEntityState(IMC::EntityState::ESTA_NORMAL, Utils::String::str(DTR(m_bufer_entity)));
-          }
+          reportFixState();
+        }
+      }
+
+      //! Report the quality of the last fix in the entity state.
+      void
+      reportFixState(void)
+      {
+        std::memset(&m_bufer_entity, '\0', sizeof(m_bufer_entity));
+        if (m_fix.validity & IMC::GpsFix::GFV_VALID_POS)
+        {
+          std::sprintf(m_bufer_entity, "active - hdop: %.2f , Sat: %d", m_fix.hdop, m_fix.satellites);
+          setEntityState(IMC::EntityState::ESTA_NORMAL, Utils::String::str(DTR(m_bufer_entity)));
+        }
+        else
+        {
+          std::sprintf(m_bufer_entity, "wait gps fix - hdop: %.2f , Sat: %d", m_fix.hdop, m_fix.satellites);
+          setEntityState(IMC::EntityState::ESTA_NORMAL, Utils::String::str(DTR(m_bufer_entity)));
         }
       }
 
@@ -756,6 +935,365 @@ namespace Sensors
         }
       }
 
+      //! Open the raw observations log.
+      //! @param[in] path log file path.
+      void
+      openRawLog(const Path& path)
+      {
+        if (path == m_raw_path)
+          return;
+
+        closeRawLog();
+
+        m_raw_path = path;
+        m_raw_file.open(m_raw_path.c_str(), std::ofstream::app | std::ios::binary);
+        debug("opening %s", m_raw_path.c_str());
+      }
+
+      //! Close the raw observations log.
+      void
+      closeRawLog(void)
+      {
+        if (!m_raw_file.is_open())
+          return;
+
+        m_raw_file.close();
+        if (m_raw_path.size() == 0)
+        {
+          debug("removing empty log '%s'", m_raw_path.c_str());
+          m_raw_path.remove();
+        }
+
+        m_raw_path = Path();
+      }
+
+      //! Store a frame in the raw observations log.
+      //! @param[in] frame complete frame.
+      void
+      logRaw(const std::vector<uint8_t>& frame)
+      {
+        if (m_raw_file.is_open())
+          m_raw_file.write((const char*)&frame[0], frame.size());
+      }
+
+      //! Read a little-endian field of a binary message.
+      //! @param[in] data message data.
+      //! @param[in] offset field offset.
+      //! @return field value.
+      template <typename T>
+      T
+      getField(const uint8_t* data, size_t offset)
+      {
+        T value;
+        ByteCopy::fromLE(value, data + offset);
+        return value;
+      }
+
+      //! Fill the UTC date and time of the fix from GPS time.
+      //! @param[in] week GPS week number.
+      //! @param[in] tow GPS time of week (s).
+      void
+      setGpsTime(unsigned week, double tow)
+      {
+        double utc = c_gps_epoch + week * c_gps_week + tow - m_leap_seconds;
+        Time::BrokenDown bdt((time_t)utc);
+
+        m_fix.utc_year = bdt.year;
+        m_fix.utc_month = bdt.month;
+        m_fix.utc_day = bdt.day;
+        m_fix.utc_time = bdt.hour * 3600 + bdt.minutes * 60 + bdt.seconds + (utc - std::floor(utc));
+        m_fix.validity |= IMC::GpsFix::GFV_VALID_DATE | IMC::GpsFix::GFV_VALID_TIME;
+      }
+
+      //! Apply dilution of precision values of the same epoch.
+      //! @param[in] tow time of week of the fix (ms).
+      void
+      applyDOP(uint32_t tow)
+      {
+        if (tow - m_dop_tow > c_dop_max_age)
+          return;
+
+        if (m_hdop > 0)
+        {
+          m_fix.hdop = m_hdop;
+          m_fix.validity |= IMC::GpsFix::GFV_VALID_HDOP;
+        }
+
+        if (m_vdop > 0)
+        {
+          m_fix.vdop = m_vdop;
+          m_fix.validity |= IMC::GpsFix::GFV_VALID_VDOP;
+        }
+      }
+
+      //! Dispatch a fix decoded from a binary protocol.
+      //! @param[in] time arrival time of the fix.
+      void
+      dispatchFix(double time)
+      {
+        m_wdog.reset();
+        m_fix.setTimeStamp(time);
+        dispatch(m_fix, DF_KEEP_TIME);
+        reportFixState();
+      }
+
+      //! Dispatch attitude decoded from a binary protocol.
+      //! @param[in] time arrival time of the solution.
+      //! @param[in] roll roll angle (degrees).
+      //! @param[in] pitch pitch angle (degrees).
+      //! @param[in] heading heading angle (degrees).
+      void
+      dispatchAttitude(double time, double roll, double pitch, double heading)
+      {
+        m_euler.clear();
+        m_euler.phi = Angles::normalizeRadian(Angles::radians(roll));
+        m_euler.theta = Angles::normalizeRadian(Angles::radians(pitch));
+        m_euler.psi = Angles::normalizeRadian(Angles::radians(heading));
+        m_euler.setTimeStamp(time);
+        dispatch(m_euler, DF_KEEP_TIME);
+      }
+
+      //! Interpret the last UBX frame.
+      //! @param[in] time arrival time of the frame.
+      void
+      interpretUBX(double time)
+      {
+        if (m_ubx.getClass() == UBX::c_class_rxm)
+        {
+          logRaw(m_ubx.getFrame());
+          return;
+        }
+
+        if (m_ubx.getClass() != UBX::c_class_nav)
+          return;
+
+        const uint8_t* data = m_ubx.getPayload();
+        size_t size = m_ubx.getPayloadSize();
+
+        switch (m_ubx.getId())
+        {
+          case UBX::c_nav_pvt:
+            if (size >= 92)
+              interpretNavPVT(data, time);
+            break;
+
+          case UBX::c_nav_dop:
+            if (size >= 18)
+              interpretNavDOP(data);
+            break;
+
+          case UBX::c_nav_att:
+            if (size >= 32)
+              interpretNavATT(data, time);
+            break;
+        }
+      }
+
+      //! Interpret UBX NAV-PVT (navigation position velocity time
+      //! solution).
+      //! @param[in] data payload.
+      //! @param[in] time arrival time of the frame.
+      void
+      interpretNavPVT(const uint8_t* data, double time)
+      {
+        m_fix.clear();
+
+        uint8_t valid = data[11];
+        if (valid & 0x01)
+        {
+          m_fix.utc_year = getField<uint16_t>(data, 4);
+          m_fix.utc_month = data[6];
+          m_fix.utc_day = data[7];
+          m_fix.validity |= IMC::GpsFix::GFV_VALID_DATE;
+        }
+
+        if (valid & 0x02)
+        {
+          m_fix.utc_time = data[8] * 3600 + data[9] * 60 + data[10]
+          + getField<int32_t>(data, 16) * 1e-9;
+          m_fix.validity |= IMC::GpsFix::GFV_VALID_TIME;
+        }
+
+        uint8_t fix_type = data[20];
+        uint8_t flags = data[21];
+        m_fix.satellites = data[23];
+
+        if (fix_type == 1)
+          m_fix.type = IMC::GpsFix::GFT_DEAD_RECKONING;
+        else
+          m_fix.type = (flags & 0x02) ? IMC::GpsFix::GFT_DIFFERENTIAL : IMC::GpsFix::GFT_STANDALONE;
+
+        if ((flags & 0x01) && fix_type >= 2 && fix_type <= 4)
+        {
+          m_fix.lon = Angles::radians(getField<int32_t>(data, 24) * 1e-7);
+          m_fix.lat = Angles::radians(getField<int32_t>(data, 28) * 1e-7);
+          m_fix.height = getField<int32_t>(data, 32) * 1e-3;
+          m_fix.hacc = getField<uint32_t>(data, 40) * 1e-3;
+          m_fix.vacc = getField<uint32_t>(data, 44) * 1e-3;
+          m_fix.sog = getField<int32_t>(data, 60) * 1e-3;
+          m_fix.cog = Angles::normalizeRadian(Angles::radians(getField<int32_t>(data, 64) * 1e-5));
+          m_fix.validity |= IMC::GpsFix::GFV_VALID_POS | IMC::GpsFix::GFV_VALID_HACC
+          | IMC::GpsFix::GFV_VALID_VACC | IMC::GpsFix::GFV_VALID_SOG | IMC::GpsFix::GFV_VALID_COG;
+        }
+
+        applyDOP(getField<uint32_t>(data, 0));
+        dispatchFix(time);
+      }
+
+      //! Interpret UBX NAV-DOP (dilution of precision).
+      //! @param[in] data payload.
+      void
+      interpretNavDOP(const uint8_t* data)
+      {
+        m_dop_tow = getField<uint32_t>(data, 0);
+        m_vdop = getField<uint16_t>(data, 10) * 0.01f;
+        m_hdop = getField<uint16_t>(data, 12) * 0.01f;
+      }
+
+      //! Interpret UBX NAV-ATT (attitude solution).
+      //! @param[in] data payload.
+      //! @param[in] time arrival time of the frame.
+      void
+      interpretNavATT(const uint8_t* data, double time)
+      {
+        dispatchAttitude(time,
+                         getField<int32_t>(data, 8) * 1e-5,
+                         getField<int32_t>(data, 12) * 1e-5,
+                         getField<int32_t>(data, 16) * 1e-5);
+      }
+
+      //! Interpret the last SBF block.
+      //! @param[in] time arrival time of the block.
+      void
+      interpretSBF(double time)
+      {
+        uint16_t id = m_sbf.getId();
+        const std::vector<uint8_t>& block = m_sbf.getBlock();
+        const uint8_t* data = &block[0];
+        size_t size = block.size();
+
+        switch (id)
+        {
+          case SBF::c_pvt_geodetic:
+            if (size >= 95)
+              interpretPVTGeodetic(data, time);
+            return;
+
+          case SBF::c_dop:
+            if (size >= 24)
+              interpretDOP(data);
+            return;
+
+          case SBF::c_att_euler:
+            if (size >= 32)
+              interpretAttEuler(data, time);
+            return;
+
+          case SBF::c_receiver_time:
+            if (size >= 21 && (int8_t)data[20] != -128)
+              m_leap_seconds = (int8_t)data[20];
+            return;
+        }
+
+        const uint16_t* end = c_sbf_raw + sizeof(c_sbf_raw) / sizeof(c_sbf_raw[0]);
+        if (std::find(c_sbf_raw, end, id) != end)
+          logRaw(block);
+      }
+
+      //! Interpret SBF PVTGeodetic (position, velocity and time in
+      //! geodetic coordinates).
+      //! @param[in] data block.
+      //! @param[in] time arrival time of the block.
+      void
+      interpretPVTGeodetic(const uint8_t* data, double time)
+      {
+        m_fix.clear();
+
+        uint32_t tow = getField<uint32_t>(data, 8);
+        uint16_t week = getField<uint16_t>(data, 12);
+        if (tow != 0xffffffff && week != 0xffff)
+          setGpsTime(week, tow * 1e-3);
+
+        uint8_t mode = data[14] & 0x0f;
+        uint8_t error = data[15];
+        m_fix.satellites = data[74] == 255 ? 0 : data[74];
+
+        if (mode == 3)
+          m_fix.type = IMC::GpsFix::GFT_MANUAL_INPUT;
+        else
+          m_fix.type = mode > 1 ? IMC::GpsFix::GFT_DIFFERENTIAL : IMC::GpsFix::GFT_STANDALONE;
+
+        double lat = getField<double>(data, 16);
+        if (mode != 0 && error == 0 && lat != c_sbf_dnu)
+        {
+          m_fix.lat = lat;
+          m_fix.lon = getField<double>(data, 24);
+          m_fix.height = getField<double>(data, 32);
+          m_fix.validity |= IMC::GpsFix::GFV_VALID_POS;
+
+          float vn = getField<float>(data, 44);
+          float ve = getField<float>(data, 48);
+          if (vn != c_sbf_dnu && ve != c_sbf_dnu)
+          {
+            m_fix.sog = std::sqrt(vn * vn + ve * ve);
+            m_fix.validity |= IMC::GpsFix::GFV_VALID_SOG;
+          }
+
+          float cog = getField<float>(data, 56);
+          if (cog != c_sbf_dnu)
+          {
+            m_fix.cog = Angles::normalizeRadian(Angles::radians(cog));
+            m_fix.validity |= IMC::GpsFix::GFV_VALID_COG;
+          }
+
+          uint16_t hacc = getField<uint16_t>(data, 90);
+          if (hacc != 0xffff)
+          {
+            m_fix.hacc = hacc * 0.01;
+            m_fix.validity |= IMC::GpsFix::GFV_VALID_HACC;
+          }
+
+          uint16_t vacc = getField<uint16_t>(data, 92);
+          if (vacc != 0xffff)
+          {
+            m_fix.vacc = vacc * 0.01;
+            m_fix.validity |= IMC::GpsFix::GFV_VALID_VACC;
+          }
+        }
+
+        applyDOP(tow);
+        dispatchFix(time);
+      }
+
+      //! Interpret SBF DOP (dilution of precision).
+      //! @param[in] data block.
+      void
+      interpretDOP(const uint8_t* data)
+      {
+        m_dop_tow = getField<uint32_t>(data, 8);
+        m_hdop = getField<uint16_t>(data, 20) * 0.01f;
+        m_vdop = getField<uint16_t>(data, 22) * 0.01f;
+      }
+
+      //! Interpret SBF AttEuler (attitude from multi-antenna
+      //! receivers).
+      //! @param[in] data block.
+      //! @param[in] time arrival time of the block.
+      void
+      interpretAttEuler(const uint8_t* data, double time)
+      {
+        float heading = getField<float>(data, 20);
+        if (data[15] != 0 || heading == c_sbf_dnu)
+          return;
+
+        float pitch = getField<float>(data, 24);
+        float roll = getField<float>(data, 28);
+        dispatchAttitude(time,
+                         roll == c_sbf_dnu ? 0 : roll,
+                         pitch == c_sbf_dnu ? 0 : pitch,
+                         heading);
+      }
+
       void
       onMain(void)
       {
@@ -0,0 +1,133 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef SENSORS_GPS_UBX_HPP_INCLUDED_
+#define SENSORS_GPS_UBX_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Framer.hpp"
+
+namespace Sensors
+{
+  namespace GPS
+  {
+    using DUNE_NAMESPACES;
+
+    //! Framer of u-blox UBX binary messages. A frame starts with two
+    //! synchronization bytes (0xB5 0x62), followed by the message
+    //! class and identifier, a little-endian payload length, the
+    //! payload and an 8-bit Fletcher checksum of everything between
+    //! the synchronization bytes and the checksum.
+    class UBX: public Framer
+    {
+    public:
+      //! Navigation results class.
+      static const uint8_t c_class_nav = 0x01;
+      //! Receiver manager class (raw measurements).
+      static const uint8_t c_class_rxm = 0x02;
+      //! Attitude solution.
+      static const uint8_t c_nav_att = 0x05;
+      //! Dilution of precision.
+      static const uint8_t c_nav_dop = 0x04;
+      //! Position, velocity and time solution.
+      static const uint8_t c_nav_pvt = 0x07;
+      //! Size of the header (synchronization, class, identifier and length).
+      static const size_t c_header_size = 6;
+      //! Maximum payload size.
+      static const size_t c_max_payload = 8192;
+
+      UBX(void):
+        Framer(0xB5, 0x62, c_header_size)
+      { }
+
+      //! Retrieve the class of the last frame.
+      uint8_t
+      getClass(void) const
+      {
+        return m_frame[2];
+      }
+
+      //! Retrieve the identifier of the last frame.
+      uint8_t
+      getId(void) const
+      {
+        return m_frame[3];
+      }
+
+      //! Retrieve the payload of the last frame.
+      const uint8_t*
+      getPayload(void) const
+      {
+        return &m_frame[c_header_size];
+      }
+
+      //! Retrieve the payload size of the last frame.
+      size_t
+      getPayloadSize(void) const
+      {
+        return m_size - c_header_size - 2;
+      }
+
+      //! Retrieve the last frame, including framing bytes.
+      const std::vector<uint8_t>&
+      getFrame(void) const
+      {
+        return m_frame;
+      }
+
+    private:
+      size_t
+      getFrameSize(void) const
+      {
+        uint16_t length = m_frame[4] | (m_frame[5] << 8);
+        if (length > c_max_payload)
+          return 0;
+
+        return c_header_size + length + 2;
+      }
+
+      bool
+      isValid(void) const
+      {
+        uint8_t a = 0;
+        uint8_t b = 0;
+        Algorithms::FletcherChecksum::compute(&m_frame[2], m_size - 4, a, b);
+        return a == m_frame[m_size - 2] && b == m_frame[m_size - 1];
+      }
+    };
+  }
+}
+
+#endif
@@ -373,7 +373,7 @@ namespace Sensors
 
         // Read response.
         size_t rv = m_uart->read(m_bfr, c_bfr_size);
-        m_tstamp = Clock::getSinceEpoch();
+        m_tstamp = m_uart->getLastReadTime();
 
         if (rv == 0)
         {
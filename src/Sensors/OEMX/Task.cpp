@@ -423,9 +423,9 @@ namespace Sensors
           if (!Poll::poll(*m_uart, c_timeout_uart))
             continue;
 
-          m_tstamp = Clock::getSinceEpoch();
           if(m_driver->haveNewData(m_numberSensors))
           {
+            m_tstamp = m_uart->getLastReadTime();
             formateDataCTD();
             dispatchData();
             setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
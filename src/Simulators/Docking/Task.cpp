@@ -283,7 +283,7 @@ namespace Simulators
       {
         while (!stopping())
         {
-          waitForMessages(1.0);
+          waitForMessages();
         }
       }
     };
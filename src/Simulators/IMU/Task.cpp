@@ -265,7 +265,7 @@ namespace Simulators
       onMain(void)
       {
         while (!stopping())
-          waitForMessages(1.0);
+          waitForMessages();
       }
     };
   }
@@ -156,7 +156,7 @@ namespace Simulators
       {
         while (!stopping())
         {
-          waitForMessages(1.0);
+          waitForMessages();
         }
       }
     };
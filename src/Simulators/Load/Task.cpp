@@ -0,0 +1,412 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Simulators
+{
+  //! This task generates synthetic sensor data at configurable rates
+  //! and sizes, to drive logging, transports, the message bus and
+  //! processing pipelines to saturation without sensor hardware.
+  //!
+  //! Each instance generates one stream: sidescan SonarData,
+  //! CompressedImage frames, Acceleration and AngularVelocity pairs
+  //! or DevDataBinary blobs. Messages are dispatched in bursts at a
+  //! fixed rate, optionally alternating active and idle periods.
+  //! Content is derived from a seeded pseudo-random generator, so
+  //! two runs with the same configuration produce the same data.
+  //!
+  //! @author agent
+  namespace Load
+  {
+    using DUNE_NAMESPACES;
+
+    //! Statistics report period.
+    static const double c_report_period = 10.0;
+    //! Maximum schedule delay before bursts are dropped.
+    static const double c_max_delay = 1.0;
+    //! Sidescan frequency.
+    static const unsigned c_sonar_frequency = 450000;
+    //! Sidescan range.
+    static const unsigned c_sonar_range = 50;
+    //! Standard gravity.
+    static const double c_gravity = 9.80665;
+
+    //! Generated streams.
+    enum Stream
+    {
+      //! Sidescan pings.
+      ST_SONAR,
+      //! Camera frames.
+      ST_IMAGE,
+      //! Inertial measurements.
+      ST_IMU,
+      //! Opaque device data.
+      ST_BINARY
+    };
+
+    //! %Task arguments.
+    struct Arguments
+    {
+      //! Generated stream.
+      std::string stream;
+      //! Burst rate.
+      double rate;
+      //! Messages per burst.
+      unsigned burst;
+      //! Payload size.
+      unsigned size;
+      //! Active time.
+      double active_time;
+      //! Idle time.
+      double idle_time;
+      //! PRNG type.
+      std::string prng_type;
+      //! PRNG seed.
+      int prng_seed;
+    };
+
+    struct Task: public DUNE::Tasks::Task
+    {
+      //! Task arguments.
+      Arguments m_args;
+      //! Generated stream.
+      Stream m_stream;
+      //! Pseudo-random generator.
+      Random::Generator* m_prng;
+      //! Pre-generated content, sampled by each message.
+      std::vector<char> m_pool;
+      //! Sonar ping.
+      IMC::SonarData m_sonar;
+      //! Camera frame.
+      IMC::CompressedImage m_image;
+      //! Acceleration.
+      IMC::Acceleration m_accel;
+      //! Angular velocity.
+      IMC::AngularVelocity m_agvel;
+      //! Device data.
+      IMC::DevDataBinary m_binary;
+      //! Number of generated messages.
+      uint64_t m_sequence;
+      //! Messages dispatched since last report.
+      unsigned m_count;
+      //! Payload bytes dispatched since last report.
+      uint64_t m_bytes;
+      //! Bursts dropped since last report.
+      unsigned m_dropped;
+      //! Statistics report timer.
+      Time::Counter<double> m_report_timer;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        DUNE::Tasks::Task(name, ctx),
+        m_stream(ST_BINARY),
+        m_prng(NULL),
+        m_sequence(0),
+        m_count(0),
+        m_bytes(0),
+        m_dropped(0)
+      {
+        param("Stream", m_args.stream)
+        .defaultValue("DevDataBinary")
+        .values("SonarData, CompressedImage, IMU, DevDataBinary")
+        .description("Type of generated data");
+
+        param("Burst Rate", m_args.rate)
+        .defaultValue("10")
+        .minimumValue("0.01")
+        .units(Units::Hertz)
+        .description("Number of bursts per second while active");
+
+        param("Burst Length", m_args.burst)
+        .defaultValue("1")
+        .minimumValue("1")
+        .description("Number of messages dispatched back to back in each burst");
+
+        param("Payload Size", m_args.size)
+        .defaultValue("1024")
+        .minimumValue("1")
+        .maximumValue("60000")
+        .units(Units::Byte)
+        .description("Size of the data of each message (ignored by IMU)");
+
+        param("Active Time", m_args.active_time)
+        .defaultValue("0")
+        .minimumValue("0")
+        .units(Units::Second)
+        .description("Duration of active periods, zero to generate continuously");
+
+        param("Idle Time", m_args.idle_time)
+        .defaultValue("0")
+        .minimumValue("0")
+        .units(Units::Second)
+        .description("Duration of idle periods between active periods");
+
+        param("PRNG Type", m_args.prng_type)
+        .defaultValue(Random::Factory::c_default);
+
+        param("PRNG Seed", m_args.prng_seed)
+        .defaultValue("1");
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        if (m_args.stream == "SonarData")
+          m_stream = ST_SONAR;
+        else if (m_args.stream == "CompressedImage")
+          m_stream = ST_IMAGE;
+        else if (m_args.stream == "IMU")
+          m_stream = ST_IMU;
+        else
+          m_stream = ST_BINARY;
+      }
+
+      void
+      onResourceAcquisition(void)
+      {
+        m_prng = Random::Factory::create(m_args.prng_type, m_args.prng_seed);
+      }
+
+      void
+      onResourceInitialization(void)
+      {
+        // Messages sample windows of a pool twice the payload size.
+        m_pool.resize(2 * m_args.size);
+        for (size_t i = 0; i < m_pool.size(); ++i)
+          m_pool[i] = (char)(m_prng->random() & 0xff);
+
+        m_sonar.type = IMC::SonarData::ST_SIDESCAN;
+        m_sonar.frequency = c_sonar_frequency;
+        m_sonar.min_range = 0;
+        m_sonar.max_range = c_sonar_range;
+        m_sonar.bits_per_point = 8;
+        m_sonar.scale_factor = 1.0f;
+        m_sonar.data.resize(m_args.size);
+
+        m_image.data.resize(m_args.size);
+        m_binary.value.resize(m_args.size);
+
+        m_report_timer.setTop(c_report_period);
+        setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        Memory::clear(m_prng);
+      }
+
+      //! Copy a window of the content pool.
+      //! @param[out] dst destination.
+      void
+      sample(std::vector<char>& dst)
+      {
+        size_t offset = (m_sequence * 7919) % (m_pool.size() - dst.size() + 1);
+        std::memcpy(&dst[0], &m_pool[offset], dst.size());
+      }
+
+      //! Generate a sidescan ping: speckle, with a bottom return
+      //! whose range drifts slowly on each side.
+      void
+      generateSonar(void)
+      {
+        sample(m_sonar.data);
+
+        size_t half = m_sonar.data.size() / 2;
+        size_t bottom = (size_t)(half * (0.3 + 0.1 * std::sin(m_sequence * 0.01)));
+        for (size_t i = 0; i < half; ++i)
+        {
+          uint8_t level = (uint8_t)m_sonar.data[half + i] >> 3;
+          if (i >= bottom)
+            level += 96 + (level >> 1);
+
+          // Port side is stored from far to near range.
+          m_sonar.data[half + i] = (char)level;
+          m_sonar.data[half - 1 - i] = (char)level;
+        }
+
+        dispatch(m_sonar);
+        m_bytes += m_sonar.data.size();
+      }
+
+      //! Generate a camera frame with JPEG start and end markers.
+      void
+      generateImage(void)
+      {
+        sample(m_image.data);
+        m_image.frameid = (uint8_t)m_sequence;
+
+        std::vector<char>& d = m_image.data;
+        if (d.size() >= 4)
+        {
+          d[0] = (char)0xff;
+          d[1] = (char)0xd8;
+          d[d.size() - 2] = (char)0xff;
+          d[d.size() - 1] = (char)0xd9;
+        }
+
+        dispatch(m_image);
+        m_bytes += d.size();
+      }
+
+      //! Generate inertial measurements of a vehicle rolling and
+      //! pitching gently.
+      void
+      generateIMU(void)
+      {
+        double t = m_sequence / m_args.rate;
+        double phi = 0.05 * std::sin(0.5 * t);
+        double theta = 0.03 * std::sin(0.3 * t);
+
+        m_accel.time = t;
+        m_accel.x = c_gravity * std::sin(theta) + m_prng->gaussian(0, 0.02);
+        m_accel.y = -c_gravity * std::sin(phi) + m_prng->gaussian(0, 0.02);
+        m_accel.z = -c_gravity * std::cos(phi) * std::cos(theta) + m_prng->gaussian(0, 0.02);
+        dispatch(m_accel);
+
+        m_agvel.time = t;
+        m_agvel.x = 0.025 * std::cos(0.5 * t) + m_prng->gaussian(0, 0.001);
+        m_agvel.y = 0.009 * std::cos(0.3 * t) + m_prng->gaussian(0, 0.001);
+        m_agvel.z = m_prng->gaussian(0, 0.001);
+        dispatch(m_agvel);
+
+        m_bytes += m_accel.getPayloadSerializationSize() + m_agvel.getPayloadSerializationSize();
+      }
+
+      //! Generate opaque device data.
+      void
+      generateBinary(void)
+      {
+        sample(m_binary.value);
+        dispatch(m_binary);
+        m_bytes += m_binary.value.size();
+      }
+
+      //! Dispatch one burst of messages.
+      void
+      generate(void)
+      {
+        for (unsigned i = 0; i < m_args.burst; ++i)
+        {
+          switch (m_stream)
+          {
+            case ST_SONAR:
+              generateSonar();
+              break;
+            case ST_IMAGE:
+              generateImage();
+              break;
+            case ST_IMU:
+              generateIMU();
+              break;
+            case ST_BINARY:
+              generateBinary();
+              break;
+          }
+
+          ++m_sequence;
+          ++m_count;
+        }
+      }
+
+      //! Report achieved throughput.
+      void
+      report(void)
+      {
+        double elapsed = m_report_timer.getElapsed();
+        if (elapsed <= 0)
+          return;
+
+        debug("%0.1f msg/s, %0.1f KiB/s", m_count / elapsed, m_bytes / elapsed / 1024.0);
+
+        if (m_dropped > 0)
+          war(DTR("unable to sustain rate: %u bursts dropped"), m_dropped);
+
+        m_count = 0;
+        m_bytes = 0;
+        m_dropped = 0;
+        m_report_timer.reset();
+      }
+
+      void
+      onMain(void)
+      {
+        double period = 1.0 / m_args.rate;
+        double start = Clock::get();
+        double next = start;
+
+        while (!stopping())
+        {
+          if (m_report_timer.overflow())
+            report();
+
+          double now = Clock::get();
+          if (now < next)
+          {
+            waitForMessages(next - now);
+            continue;
+          }
+
+          consumeMessages();
+
+          // Skip idle periods.
+          if (m_args.active_time > 0 && m_args.idle_time > 0)
+          {
+            double cycle = m_args.active_time + m_args.idle_time;
+            double phase = std::fmod(now - start, cycle);
+            if (phase >= m_args.active_time)
+            {
+              next = now + (cycle - phase);
+              continue;
+            }
+          }
+
+          generate();
+
+          next += period;
+          if (now - next > c_max_delay)
+          {
+            unsigned skipped = (unsigned)((now - next) / period);
+            m_dropped += skipped;
+            next += skipped * period;
+          }
+        }
+      }
+    };
+  }
+}
+
+DUNE_TASK
@@ -244,7 +244,7 @@ namespace Simulators
       {
         while (!stopping())
         {
-          waitForMessages(1.0);
+          waitForMessages();
         }
       }
     };
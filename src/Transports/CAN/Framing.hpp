@@ -0,0 +1,200 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef TRANSPORTS_CAN_FRAMING_HPP_INCLUDED_
+#define TRANSPORTS_CAN_FRAMING_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace CAN
+  {
+    using DUNE_NAMESPACES;
+
+    //! Start-of-packet flag.
+    static const uint8_t c_start = 0x80;
+    //! Sequence number mask.
+    static const uint8_t c_seq_mask = 0x7f;
+    //! Mask of the node identifier bits.
+    static const unsigned c_node_mask = 0x7f;
+    //! Packet data carried by each frame.
+    static const unsigned c_frame_data = Hardware::CANSocket::c_max_payload - 1;
+
+    //! Splits packets of a node in frames.
+    class Fragmenter
+    {
+    public:
+      Fragmenter(void):
+        m_id(0),
+        m_seq(0)
+      { }
+
+      //! Set the identifier of the frames.
+      //! @param[in] id frame identifier.
+      void
+      setIdentifier(uint32_t id)
+      {
+        m_id = id;
+      }
+
+      //! Split a packet in frames.
+      //! @param[in] p packet data.
+      //! @param[in] n packet size.
+      //! @param[out] frames frames carrying the packet.
+      void
+      split(const uint8_t* p, unsigned n, std::vector<Hardware::CANSocket::Frame>& frames)
+      {
+        frames.resize((n + c_frame_data - 1) / c_frame_data);
+
+        for (unsigned i = 0, f = 0; i < n; i += c_frame_data, ++f)
+        {
+          Hardware::CANSocket::Frame& frame = frames[f];
+          unsigned len = std::min(c_frame_data, n - i);
+          frame.id = m_id;
+          frame.data[0] = m_seq | (i == 0 ? c_start : 0);
+          std::memcpy(frame.data + 1, p + i, len);
+          frame.length = len + 1;
+          m_seq = (m_seq + 1) & c_seq_mask;
+        }
+      }
+
+    private:
+      //! Frame identifier.
+      uint32_t m_id;
+      //! Sequence number of the next frame.
+      uint8_t m_seq;
+    };
+
+    //! Reassembles packets from the frames of remote nodes. Frames
+    //! are tracked per sender and a missing frame discards the
+    //! packet in progress.
+    class Reassembler
+    {
+    public:
+      Reassembler(void):
+        m_node(0),
+        m_lost(0)
+      { }
+
+      //! Set the identifier of this node, whose frames are ignored.
+      //! @param[in] node node identifier.
+      void
+      setNode(unsigned node)
+      {
+        m_node = node;
+      }
+
+      //! Handle one frame.
+      //! @param[in] frame received frame.
+      //! @return parser of the sender to which the packet data of
+      //! the frame (after its first byte) must be fed, or NULL if
+      //! the frame must be ignored.
+      IMC::Parser*
+      handleFrame(const Hardware::CANSocket::Frame& frame)
+      {
+        if (frame.extended || frame.rtr || frame.length < 2)
+          return NULL;
+
+        unsigned node = frame.id & c_node_mask;
+        if (node == m_node)
+          return NULL;
+
+        Source& src = m_sources[node];
+        uint8_t seq = frame.data[0] & c_seq_mask;
+
+        if (frame.data[0] & c_start)
+        {
+          src.parser.reset();
+          src.sync = true;
+        }
+        else if (!src.sync || seq != src.seq)
+        {
+          if (src.sync)
+            m_lost += (seq - src.seq) & c_seq_mask;
+
+          src.parser.reset();
+          src.sync = false;
+          return NULL;
+        }
+
+        src.seq = (seq + 1) & c_seq_mask;
+        return &src.parser;
+      }
+
+      //! Get the number of frames lost so far.
+      //! @return number of frames.
+      unsigned
+      getLost(void) const
+      {
+        return m_lost;
+      }
+
+      //! Forget the state of all senders.
+      void
+      clear(void)
+      {
+        m_sources.clear();
+      }
+
+    private:
+      //! Reassembly state of a remote node.
+      struct Source
+      {
+        //! Parser of reassembled data.
+        IMC::Parser parser;
+        //! Next expected sequence number.
+        uint8_t seq;
+        //! True if the packet in progress is complete so far.
+        bool sync;
+
+        Source(void):
+          seq(0),
+          sync(false)
+        { }
+      };
+
+      //! Identifier of this node.
+      unsigned m_node;
+      //! Reassembly state by node identifier.
+      std::map<unsigned, Source> m_sources;
+      //! Number of frames lost.
+      unsigned m_lost;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,213 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Framing.hpp"
+
+namespace Transports
+{
+  //! IMC transport over a SocketCAN interface.
+  //!
+  //! Serialized IMC packets are split in classic CAN frames whose
+  //! identifier is the sum of a base identifier and the node
+  //! identifier of the sender. The first byte of each frame holds a
+  //! start-of-packet flag (most significant bit) and a 7 bit
+  //! sequence number incremented by the sender for every frame, the
+  //! remaining seven bytes carry packet data. Frames are reassembled
+  //! per sender and a missing frame discards the packet in progress.
+  //!
+  //! @author agent
+  namespace CAN
+  {
+    using DUNE_NAMESPACES;
+
+    //! Number of frames read in a single system call.
+    static const unsigned c_batch_size = 64;
+    //! Minimum interval between write error reports.
+    static const double c_error_period = 5.0;
+
+    struct Arguments
+    {
+      //! Network interface.
+      std::string interface;
+      //! Base identifier.
+      unsigned base_id;
+      //! Node identifier, negative to derive it from the system id.
+      int node_id;
+    };
+
+    struct Task: public Tasks::SimpleTransport
+    {
+      //! Task arguments.
+      Arguments m_args;
+      //! CAN socket.
+      Hardware::CANSocket* m_can;
+      //! Received frames.
+      std::vector<Hardware::CANSocket::Frame> m_frames;
+      //! Frames of the packet being sent.
+      std::vector<Hardware::CANSocket::Frame> m_tx_frames;
+      //! Packet splitter.
+      Fragmenter m_fragmenter;
+      //! Packet reassembler.
+      Reassembler m_reassembler;
+      //! Identifier of this node.
+      unsigned m_node;
+      //! Packets dropped by write errors since the last report.
+      unsigned m_write_errors;
+      //! Write error report timer.
+      Time::Counter<double> m_error_timer;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        Tasks::SimpleTransport(name, ctx),
+        m_can(NULL),
+        m_frames(c_batch_size),
+        m_node(0),
+        m_write_errors(0)
+      {
+        param("Interface", m_args.interface)
+        .defaultValue("can0")
+        .description("SocketCAN network interface (e.g., can0 or vcan0)");
+
+        param("Base Identifier", m_args.base_id)
+        .defaultValue("1536")
+        .description("Identifier of node zero, must be a multiple of 128");
+
+        param("Node Identifier", m_args.node_id)
+        .defaultValue("-1")
+        .minimumValue("-1")
+        .maximumValue("127")
+        .description("Identifier of this node in the CAN bus, -1 to use "
+                     "the lower seven bits of the IMC system identifier");
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        if ((m_args.base_id & c_node_mask) != 0 || m_args.base_id > 0x780)
+          throw std::runtime_error(DTR("invalid base identifier"));
+
+        if (m_args.node_id < 0)
+          m_node = getSystemId() & c_node_mask;
+        else
+          m_node = m_args.node_id;
+
+        m_fragmenter.setIdentifier(m_args.base_id | m_node);
+        m_reassembler.setNode(m_node);
+        debug("node identifier is %u", m_node);
+      }
+
+      void
+      onResourceAcquisition(void)
+      {
+        m_can = new Hardware::CANSocket(m_args.interface);
+        m_can->setFilter(m_args.base_id, ~c_node_mask);
+        m_can->setWriteIdentifier(m_args.base_id | m_node);
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        Memory::clear(m_can);
+        m_reassembler.clear();
+      }
+
+      ~Task(void)
+      {
+        onResourceRelease();
+      }
+
+      void
+      onDataTransmission(const uint8_t* p, unsigned int n)
+      {
+        m_fragmenter.split(p, n, m_tx_frames);
+
+        try
+        {
+          for (unsigned i = 0; i < m_tx_frames.size(); ++i)
+            m_can->writeFrame(m_tx_frames[i]);
+        }
+        catch (std::exception& e)
+        {
+          // A full transmit queue fails every packet, report only
+          // the first error and then a count once in a while.
+          ++m_write_errors;
+          if (m_error_timer.overflow())
+          {
+            err(DTR("write error: %s (%u packets dropped)"), e.what(), m_write_errors);
+            m_write_errors = 0;
+            m_error_timer.setTop(c_error_period);
+          }
+        }
+      }
+
+      void
+      onDataReception(uint8_t* p, unsigned int n, double timeout)
+      {
+        (void)p;
+        (void)n;
+
+        if (!Poll::poll(*m_can, timeout))
+          return;
+
+        unsigned count = 0;
+
+        try
+        {
+          count = m_can->readFrames(m_frames);
+        }
+        catch (std::exception& e)
+        {
+          err(DTR("read error: %s"), e.what());
+          return;
+        }
+
+        unsigned lost = m_reassembler.getLost();
+
+        for (unsigned i = 0; i < count; ++i)
+        {
+          const Hardware::CANSocket::Frame& frame = m_frames[i];
+          IMC::Parser* parser = m_reassembler.handleFrame(frame);
+          if (parser != NULL)
+            handleData(*parser, frame.data + 1, frame.length - 1);
+        }
+
+        if (m_reassembler.getLost() != lost)
+          debug("lost frames (%u total)", m_reassembler.getLost());
+      }
+    };
+  }
+}
+
+DUNE_TASK
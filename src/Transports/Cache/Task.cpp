@@ -294,7 +294,7 @@ namespace Transports
 
         while (!stopping())
         {
-          waitForMessages(1.0);
+          waitForMessages();
         }
       }
     };
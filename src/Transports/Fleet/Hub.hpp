@@ -0,0 +1,344 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef TRANSPORTS_FLEET_HUB_HPP_INCLUDED_
+#define TRANSPORTS_FLEET_HUB_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstddef>
+#include <map>
+#include <queue>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace Fleet
+  {
+    using DUNE_NAMESPACES;
+
+    //! Receiving side of a fleet hub.
+    class Endpoint
+    {
+    public:
+      virtual
+      ~Endpoint(void)
+      { }
+
+      //! Deliver a message sent by another vehicle. The endpoint
+      //! takes ownership of the message.
+      //! @param[in] msg message.
+      virtual void
+      deliver(IMC::Message* msg) = 0;
+    };
+
+    //! Link model applied to messages leaving an endpoint.
+    struct Link
+    {
+      //! Transmission latency (s).
+      double latency;
+      //! Probability of losing a message [0, 1].
+      double loss;
+      //! Maximum communication range (m), zero means unlimited.
+      double range;
+      //! Pseudo-random number generator used to draw losses.
+      Random::Generator* prng;
+    };
+
+    //! Process-wide message switch shared by all vehicles running
+    //! inside the same process. Messages with latency are queued and
+    //! delivered by a single thread in due-time order.
+    class Hub: public Concurrency::Thread
+    {
+    public:
+      //! Retrieve the process-wide hub.
+      //! @return hub instance.
+      static Hub&
+      get(void)
+      {
+        static Hub s_hub;
+        return s_hub;
+      }
+
+      //! Attach an endpoint to the hub.
+      //! @param[in] ep endpoint.
+      //! @param[in] id IMC address of the endpoint's vehicle.
+      void
+      attach(Endpoint* ep, unsigned id)
+      {
+        ScopedMutex m(m_life);
+
+        {
+          ScopedCondition l(m_cond);
+          Node& node = m_nodes[ep];
+          node.id = id;
+          node.located = false;
+        }
+
+        if (!m_started)
+        {
+          start();
+          m_started = true;
+        }
+      }
+
+      //! Detach an endpoint from the hub. Messages queued for the
+      //! endpoint are discarded.
+      //! @param[in] ep endpoint.
+      void
+      detach(Endpoint* ep)
+      {
+        ScopedMutex m(m_life);
+        bool last = false;
+
+        {
+          ScopedCondition l(m_cond);
+          m_nodes.erase(ep);
+
+          std::vector<Delivery> keep;
+          while (!m_queue.empty())
+          {
+            Delivery d = m_queue.top();
+            m_queue.pop();
+            if (d.to == ep)
+              delete d.msg;
+            else
+              keep.push_back(d);
+          }
+
+          for (size_t i = 0; i < keep.size(); ++i)
+            m_queue.push(keep[i]);
+
+          last = m_nodes.empty();
+        }
+
+        if (last)
+          halt();
+      }
+
+      //! Update the position of an endpoint's vehicle.
+      //! @param[in] ep endpoint.
+      //! @param[in] lat latitude (rad).
+      //! @param[in] lon longitude (rad).
+      //! @param[in] hae height above ellipsoid (m).
+      void
+      setPosition(Endpoint* ep, double lat, double lon, double hae)
+      {
+        ScopedCondition l(m_cond);
+        std::map<Endpoint*, Node>::iterator itr = m_nodes.find(ep);
+        if (itr == m_nodes.end())
+          return;
+
+        itr->second.lat = lat;
+        itr->second.lon = lon;
+        itr->second.hae = hae;
+        itr->second.located = true;
+      }
+
+      //! Send a message from an endpoint to the other endpoints.
+      //! @param[in] from sending endpoint.
+      //! @param[in] msg message.
+      //! @param[in] link link model of the sender.
+      //! @return number of endpoints the message was accepted for.
+      unsigned
+      send(Endpoint* from, const IMC::Message* msg, const Link& link)
+      {
+        ScopedCondition l(m_cond);
+
+        std::map<Endpoint*, Node>::const_iterator src = m_nodes.find(from);
+        if (src == m_nodes.end())
+          return 0;
+
+        unsigned count = 0;
+        double due = Clock::get() + link.latency;
+        std::map<Endpoint*, Node>::const_iterator itr = m_nodes.begin();
+        for (; itr != m_nodes.end(); ++itr)
+        {
+          if (itr->first == from)
+            continue;
+
+          if (msg->getDestination() != DUNE_IMC_CONST_NULL_ID
+              && msg->getDestination() != itr->second.id)
+            continue;
+
+          if (link.range > 0 && src->second.located && itr->second.located)
+          {
+            double dist = WGS84::distance(src->second.lat, src->second.lon,
+                                          src->second.hae,
+                                          itr->second.lat, itr->second.lon,
+                                          itr->second.hae);
+            if (dist > link.range)
+              continue;
+          }
+
+          if (link.loss > 0 && link.prng != NULL
+              && link.prng->uniform() < link.loss)
+            continue;
+
+          ++count;
+
+          if (link.latency <= 0)
+          {
+            itr->first->deliver(msg->clone());
+            continue;
+          }
+
+          Delivery d;
+          d.due = due;
+          d.seq = m_seq++;
+          d.to = itr->first;
+          d.msg = msg->clone();
+          m_queue.push(d);
+        }
+
+        m_cond.signal();
+        return count;
+      }
+
+    private:
+      //! Attached vehicle.
+      struct Node
+      {
+        //! IMC address.
+        unsigned id;
+        //! True if position is known.
+        bool located;
+        //! Latitude (rad).
+        double lat;
+        //! Longitude (rad).
+        double lon;
+        //! Height above ellipsoid (m).
+        double hae;
+      };
+
+      //! Pending delivery.
+      struct Delivery
+      {
+        //! Time of delivery.
+        double due;
+        //! Sequence number, keeps order among equal due times.
+        uint64_t seq;
+        //! Destination endpoint.
+        Endpoint* to;
+        //! Message.
+        IMC::Message* msg;
+
+        bool
+        operator<(const Delivery& other) const
+        {
+          // Inverted to turn std::priority_queue into a min-heap.
+          if (due != other.due)
+            return due > other.due;
+          return seq > other.seq;
+        }
+      };
+
+      //! Attached endpoints.
+      std::map<Endpoint*, Node> m_nodes;
+      //! Pending deliveries.
+      std::priority_queue<Delivery> m_queue;
+      //! Delivery sequence number.
+      uint64_t m_seq;
+      //! Lock and wake-up condition.
+      Concurrency::Condition m_cond;
+      //! Serializes starting and stopping the delivery thread.
+      Concurrency::Mutex m_life;
+      //! True if the delivery thread was started.
+      bool m_started;
+
+      Hub(void):
+        m_seq(0),
+        m_started(false)
+      { }
+
+      ~Hub(void)
+      {
+        {
+          ScopedMutex m(m_life);
+          halt();
+        }
+
+        while (!m_queue.empty())
+        {
+          delete m_queue.top().msg;
+          m_queue.pop();
+        }
+      }
+
+      //! Stop and join the delivery thread. Must be called with
+      //! the lifecycle mutex held.
+      void
+      halt(void)
+      {
+        if (!m_started)
+          return;
+
+        stop();
+
+        {
+          ScopedCondition l(m_cond);
+          m_cond.broadcast();
+        }
+
+        join();
+        m_started = false;
+      }
+
+      void
+      run(void)
+      {
+        ScopedCondition l(m_cond);
+
+        while (!isStopping())
+        {
+          if (m_queue.empty())
+          {
+            m_cond.wait();
+            continue;
+          }
+
+          double delta = m_queue.top().due - Clock::get();
+          if (delta > 0)
+          {
+            m_cond.wait(delta);
+            continue;
+          }
+
+          Delivery d = m_queue.top();
+          m_queue.pop();
+          d.to->deliver(d.msg);
+        }
+      }
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,208 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+// ISO C++ 98 headers.
+#include <set>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Hub.hpp"
+
+namespace Transports
+{
+  //! Links vehicles running inside the same process (see
+  //! dune-fleet). Messages generated by the local system are handed
+  //! to a process-wide hub that delivers them to the other vehicles'
+  //! buses, optionally subject to latency, loss and range limits.
+  //!
+  //! @author agent
+  namespace Fleet
+  {
+    using DUNE_NAMESPACES;
+
+    //! %Task arguments.
+    struct Arguments
+    {
+      //! Messages to transport.
+      std::vector<std::string> messages;
+      //! Link latency.
+      double latency;
+      //! Message loss probability.
+      double loss;
+      //! Communication range.
+      double range;
+      //! PRNG type.
+      std::string prng_type;
+      //! PRNG seed.
+      int prng_seed;
+    };
+
+    struct Task: public DUNE::Tasks::Task, public Endpoint
+    {
+      //! Task arguments.
+      Arguments m_args;
+      //! Identifiers of transported messages.
+      std::set<uint32_t> m_transports;
+      //! Link model.
+      Link m_link;
+      //! Pseudo-random number generator.
+      Random::Generator* m_prng;
+      //! True if attached to the hub.
+      bool m_attached;
+
+      Task(const std::string& name, Tasks::Context& ctx):
+        DUNE::Tasks::Task(name, ctx),
+        m_prng(NULL),
+        m_attached(false)
+      {
+        param("Transports", m_args.messages)
+        .defaultValue("")
+        .description("List of messages to transport");
+
+        param("Latency", m_args.latency)
+        .defaultValue("0")
+        .minimumValue("0")
+        .units(Units::Second)
+        .description("Delay between sending and delivering a message");
+
+        param("Loss Probability", m_args.loss)
+        .defaultValue("0")
+        .minimumValue("0")
+        .maximumValue("100")
+        .units(Units::Percentage)
+        .description("Probability of losing a message");
+
+        param("Communication Range", m_args.range)
+        .defaultValue("0")
+        .minimumValue("0")
+        .units(Units::Meter)
+        .description("Communication range (0 for infinite)");
+
+        param("PRNG Type", m_args.prng_type)
+        .defaultValue(Random::Factory::c_default);
+
+        param("PRNG Seed", m_args.prng_seed)
+        .defaultValue("-1");
+      }
+
+      void
+      onUpdateParameters(void)
+      {
+        m_link.latency = m_args.latency;
+        m_link.loss = m_args.loss * 0.01;
+        m_link.range = m_args.range;
+
+        m_transports.clear();
+        for (size_t i = 0; i < m_args.messages.size(); ++i)
+        {
+          uint32_t id = IMC::Factory::getIdFromAbbrev(m_args.messages[i]);
+          m_transports.insert(id);
+        }
+      }
+
+      void
+      onResourceAcquisition(void)
+      {
+        m_prng = Random::Factory::create(m_args.prng_type, m_args.prng_seed);
+        m_link.prng = m_prng;
+
+        // Positions are needed to enforce the communication range.
+        std::vector<std::string> list = m_args.messages;
+        if (m_transports.find(DUNE_IMC_ESTIMATEDSTATE) == m_transports.end())
+          list.push_back("EstimatedState");
+
+        bind(this, list);
+      }
+
+      void
+      onResourceInitialization(void)
+      {
+        Hub::get().attach(this, getSystemId());
+        m_attached = true;
+        setEntityState(IMC::EntityState::ESTA_NORMAL, Status::CODE_ACTIVE);
+      }
+
+      void
+      onResourceRelease(void)
+      {
+        if (m_attached)
+        {
+          Hub::get().detach(this);
+          m_attached = false;
+        }
+
+        Memory::clear(m_prng);
+      }
+
+      void
+      deliver(IMC::Message* msg)
+      {
+        dispatch(msg, DF_KEEP_TIME | DF_KEEP_SRC_EID);
+        delete msg;
+      }
+
+      void
+      consume(const IMC::Message* msg)
+      {
+        if (msg->getSource() != getSystemId())
+          return;
+
+        if (msg->getId() == DUNE_IMC_ESTIMATEDSTATE)
+        {
+          double lat = 0;
+          double lon = 0;
+          float hae = 0;
+          Coordinates::toWGS84(*static_cast<const IMC::EstimatedState*>(msg), lat, lon, hae);
+          Hub::get().setPosition(this, lat, lon, hae);
+        }
+
+        if (m_transports.find(msg->getId()) == m_transports.end())
+          return;
+
+        if (m_attached)
+          Hub::get().send(this, msg, m_link);
+      }
+
+      void
+      onMain(void)
+      {
+        while (!stopping())
+        {
+          waitForMessages();
+        }
+      }
+    };
+  }
+}
+
+DUNE_TASK
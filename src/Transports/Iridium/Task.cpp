@@ -38,6 +38,9 @@ namespace Transports
   {
     using DUNE_NAMESPACES;
 
+    //! Size of the header of IMC messages sent over Iridium.
+    static const size_t c_imc_header_size = 12;
+
     struct Arguments
     {
       //! Delay between dev updates.
@@ -50,6 +53,8 @@ namespace Transports
       std::string iridium_destination;
       //! Text messages received over Iridium are tagged with this origin
       std::string text_origin;
+      //! Drop messages already received over another link.
+      bool filter_dups;
     };
 
     struct Task: public DUNE::Tasks::Task
@@ -101,6 +106,10 @@ namespace Transports
         .description("Text messages received via Iridium will be tagged with this origin")
         .defaultValue("iridium");
 
+        param("Filter Duplicates", m_args.filter_dups)
+        .defaultValue("true")
+        .description("Drop incoming messages already received over another link");
+
         bind<IMC::Announce>(this);
         bind<IMC::IridiumMsgRx>(this);
         bind<IMC::IridiumTxStatus>(this);
@@ -261,12 +270,22 @@ namespace Transports
             DUNE::IMC::ImcIridiumMessage * irMsg =
             static_cast<DUNE::IMC::ImcIridiumMessage *>(m);
 
-            double age = Clock::getSinceEpoch() - irMsg->msg->getTimeStamp();
-            if (age < m_args.max_age_secs)
+            IMC::Message* m2 = irMsg->msg;
+            m2->setSource(irMsg->source);
+
+            // Time stamps are truncated to whole seconds and the source
+            // entity is not sent, copies are matched on their content.
+            double age = Clock::getSinceEpoch() - m2->getTimeStamp();
+            if (m_args.filter_dups && msg->data.size() >= c_imc_header_size
+                && !m_ctx.duplicates.acceptUntimed(m2, (const uint8_t*)&msg->data[0] + c_imc_header_size,
+                                                   msg->data.size() - c_imc_header_size,
+                                                   getEntityId(), Clock::get()))
+            {
+              debug("discarded IMC message of type %s already received over another link.", m2->getName());
+            }
+            else if (age < m_args.max_age_secs)
             {
-              inf("received IMC message of type %s via Iridium from %d.", irMsg->msg->getName(), irMsg->source);
-              IMC::Message* m2 = irMsg->msg;
-              m2->setSource(irMsg->source);
+              inf("received IMC message of type %s via Iridium from %d.", m2->getName(), irMsg->source);
               dispatch(m2);
             }
             else
@@ -142,7 +142,7 @@ namespace Transports
       {
         while (!stopping())
         {
-          waitForMessages(1.0);
+          waitForMessages();
         }
       }
     };
@@ -58,6 +58,10 @@ namespace Transports
       unsigned lsf_volume_size;
       // Compression method.
       std::string lsf_compression;
+      // True to delta encode messages.
+      bool lsf_delta;
+      // Maximum number of delta frames between keyframes.
+      unsigned lsf_keyframe_interval;
     };
 
     struct Task: public Tasks::Task
@@ -74,6 +78,8 @@ namespace Transports
       Compression::Methods m_compression;
       // Output file stream for LSF/LSF_GZ formats.
       std::ostream* m_lsf;
+      // Delta encoder.
+      IMC::DeltaEncoder* m_delta;
       // Path to LSF file.
       Path m_lsf_file;
       // Serialization buffer.
@@ -89,6 +95,7 @@ namespace Transports
         Tasks::Task(name, ctx),
         m_last_flush(0),
         m_lsf(NULL),
+        m_delta(NULL),
         m_active(true)
       {
         // Define configuration parameters.
@@ -101,6 +108,17 @@ namespace Transports
         .defaultValue("none")
         .description("Compression method");
 
+        param("LSF Delta Encoding", m_args.lsf_delta)
+        .defaultValue("false")
+        .description("Store messages as differences to the previous message of "
+                     "the same type and source, decoded transparently by LSF readers");
+
+        param("LSF Delta Keyframe Interval", m_args.lsf_keyframe_interval)
+        .defaultValue("100")
+        .minimumValue("1")
+        .description("Maximum number of consecutive delta encoded messages "
+                     "of the same type and source");
+
         param("LSF Volume Size", m_args.lsf_volume_size)
         .units(Units::Mebibyte)
         .defaultValue("0");
@@ -137,6 +155,7 @@ namespace Transports
       onResourceRelease(void)
       {
         Memory::clear(m_lsf);
+        Memory::clear(m_delta);
       }
 
       void
@@ -294,6 +313,10 @@ namespace Transports
           ifs.read(bfr, sizeof(bfr));
           m_lsf->write(bfr, ifs.gcount());
         }
+
+        // The file may contain packets of any stream.
+        if (m_delta != NULL)
+          m_delta->reset();
       }
 
       void
@@ -355,6 +378,14 @@ namespace Transports
         else
           m_lsf = new Compression::FileOutput(m_lsf_file.c_str(), m_compression);
 
+        Memory::clear(m_delta);
+        if (m_args.lsf_delta)
+        {
+          m_delta = new IMC::DeltaEncoder(m_args.lsf_keyframe_interval);
+          m_delta->writeMarker(m_buffer);
+          m_lsf->write(m_buffer.getBufferSigned(), m_buffer.getSize());
+        }
+
         // Log LoggingControl to facilitate posterior conversion to LLF.
         m_log_ctl.op = IMC::LoggingControl::COP_STARTED;
         m_log_ctl.name = m_ctx.dir_log.suffix(m_dir);
@@ -424,7 +455,11 @@ namespace Transports
         if (m_lsf == NULL)
           return;
 
-        IMC::Packet::serialize(msg, m_buffer);
+        if (m_delta != NULL)
+          m_delta->encode(msg, m_buffer);
+        else
+          IMC::Packet::serialize(msg, m_buffer);
+
         m_lsf->write(m_buffer.getBufferSigned(), m_buffer.getSize());
       }
 
@@ -98,6 +98,8 @@ namespace Transports
       std::string elabel_voltage;
       //! Radio reports periodicity.
       double radio_period;
+      //! Drop messages already received over another link.
+      bool filter_dups;
 
     };
 
@@ -244,6 +246,10 @@ namespace Transports
         .defaultValue("Autopilot")
           .description("Entity label for battery Voltage");
 
+        param("Filter Duplicates", m_args.filter_dups)
+        .defaultValue("true")
+        .description("Drop incoming messages already received over another link");
+
 
         m_conn_watchdog.setTop(30);
 
@@ -607,7 +613,8 @@ namespace Transports
               }
             debug("configuration completed");
             m_radio->clearNewRxData();
-            m_telemetry = new Telemetry(this, (uint8_t) m_systemID, m_radio_names, m_radio_addrs, m_radio->maxDataPacket());
+            m_telemetry = new Telemetry(this, (uint8_t) m_systemID, m_radio_names, m_radio_addrs, m_radio->maxDataPacket(),
+                                        m_args.filter_dups ? &m_ctx.duplicates : NULL);
              m_fast_treport_counter.setTop(m_args.radio_period);
             m_sm_state = SM_ACT_DONE;
             /* no break */
@@ -56,8 +56,10 @@ namespace Transports
     {
     public:
       //! Constructor.
-      Telemetry(Tasks::Task* task, uint8_t system, MapName radio_names, MapAddr radio_addrs, int max_packet_size):
+      Telemetry(Tasks::Task* task, uint8_t system, MapName radio_names, MapAddr radio_addrs, int max_packet_size,
+                IMC::DuplicateFilter* duplicates):
         m_task(task),
+        m_duplicates(duplicates),
         m_tx_telemetry_State(IDLE),
         m_rx_telemetry_State(IDLE),
         local_tx_sync(0),
@@ -684,8 +686,22 @@ namespace Transports
            uint16_t imc_dst =  m_task->resolveSystemName(src_system);
            m->setSource(imc_src);
            m->setDestination(imc_dst);
-           m->setTimeStamp(rxmsg.timestamp);
+           // Frames do not carry the time stamp of the sender.
+           m->setTimeStamp();
            m->deserializeFields((const unsigned char *) &data[2], rxmsg.msg.size()-2);
+
+           // Frames carry neither time stamp nor source entity, copies
+           // are matched on their content.
+           if (m_duplicates != NULL
+               && !m_duplicates->acceptUntimed(m, (const uint8_t*)&data[2], rxmsg.msg.size() - 2,
+                                               m_task->getEntityId(), Clock::get()))
+           {
+             m_task->debug("Telemetry IMC message '%s' already received over another link.", m->getName());
+             rxmsg.state = MSG_PROCESSED;
+             delete m;
+             return;
+           }
+
            m_task->dispatch(m, DF_KEEP_TIME | DF_LOOP_BACK);
            m_task->debug("Telemetry IMC message successfully parsed as '%s'.", m->getName());
            rxmsg.state = MSG_PROCESSED;
@@ -731,6 +747,8 @@ namespace Transports
 
       //! Pointer to task.
       Tasks::Task* m_task;
+      //! Shared filter of duplicate messages, if enabled.
+      IMC::DuplicateFilter* m_duplicates;
       RepotImcData m_repotdata;
       XxMesg acquisition_Rx_Frame;
       XxMesg m_tx_mesg;
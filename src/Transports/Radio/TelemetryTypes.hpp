@@ -173,6 +173,7 @@ namespace Transports
         sync=0;
         past_sync = 0;
         error = false;
+        timestamp = 0;
         n_parts_status = 0;
         n_parts_end_sync =0;
         src_id = 0;
@@ -0,0 +1,258 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef TRANSPORTS_UDP_LINK_HPP_INCLUDED_
+#define TRANSPORTS_UDP_LINK_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <map>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+namespace Transports
+{
+  namespace UDP
+  {
+    using DUNE_NAMESPACES;
+
+    //! Estimator gain.
+    static const double c_gain = 0.125;
+    //! Number of heartbeat intervals used to estimate the period.
+    static const unsigned c_period_window = 15;
+    //! Number of one-way delays over which the minimum is taken.
+    static const unsigned c_base_window = 30;
+    //! Adaptation period (s).
+    static const double c_adapt_period = 1.0;
+    //! Additive increase step.
+    static const double c_increase = 0.1;
+    //! Multiplicative decrease factor.
+    static const double c_decrease = 0.5;
+
+    //! Quality estimate and send rate state of the link to one node.
+    //! Loss is estimated from gaps between the node's heartbeats and
+    //! queueing delay from the growth of their one-way delay over its
+    //! recent minimum, which makes it independent of clock offsets.
+    //! Both references are taken over a window of recent heartbeats,
+    //! so a burst, a duplicate or a step of the node's clock only
+    //! skews them until it leaves the window.
+    class Link
+    {
+    public:
+      Link(void):
+        m_hb_last(-1),
+        m_hb_stamp(-1),
+        m_hb_period(-1),
+        m_loss(0),
+        m_owd_base(-1),
+        m_delay(0),
+        m_scale(1),
+        m_adapted(-1)
+      { }
+
+      //! Account a heartbeat received from the node.
+      //! @param[in] stamp heartbeat time stamp.
+      //! @param[in] now current time.
+      void
+      onHeartbeat(double stamp, double now)
+      {
+        // Intervals are measured with the node's time stamps, which
+        // are not compressed by bursts. Duplicated heartbeats and
+        // backward steps of the node's clock carry no interval.
+        if (m_hb_last >= 0 && stamp > m_hb_stamp)
+        {
+          double dt = stamp - m_hb_stamp;
+
+          // Losses can only lengthen intervals, so the nominal period
+          // is the lower quartile, which holds under heavy loss.
+          pushWindow(m_gaps, dt, c_period_window);
+          m_hb_period = getLowerQuartile(m_gaps);
+
+          m_loss += c_gain * (getGapLoss(dt) - m_loss);
+        }
+
+        m_hb_stamp = stamp;
+        m_hb_last = now;
+
+        double owd = now - stamp;
+        pushWindow(m_owds, owd, c_base_window);
+        m_owd_base = *std::min_element(m_owds.begin(), m_owds.end());
+
+        m_delay += c_gain * ((owd - m_owd_base) - m_delay);
+      }
+
+      //! Update the send rate scale, at most once per second.
+      //! Additive increase while the link is healthy, multiplicative
+      //! decrease when loss or queueing delay exceed the thresholds.
+      //! @param[in] now current time.
+      //! @param[in] loss_thr loss threshold [0, 1].
+      //! @param[in] delay_thr queueing delay threshold (s).
+      //! @return true if the scale changed, false otherwise.
+      bool
+      adapt(double now, double loss_thr, double delay_thr)
+      {
+        if (m_adapted >= 0 && now - m_adapted < c_adapt_period)
+          return false;
+
+        m_adapted = now;
+
+        // No heartbeats yet, nothing to base a decision on.
+        if (m_hb_last < 0 || m_hb_period <= 0)
+          return false;
+
+        double prev = m_scale;
+
+        // A silent node counts as loss even before the next heartbeat.
+        double loss = std::max(m_loss, getGapLoss(now - m_hb_last));
+
+        if (loss > loss_thr || m_delay > delay_thr)
+          m_scale *= c_decrease;
+        else
+          m_scale = std::min(1.0, m_scale + c_increase);
+
+        return m_scale != prev;
+      }
+
+      //! Check if a message may be sent now.
+      //! @param[in] key message identifier and source entity.
+      //! @param[in] floor minimum rate (Hz).
+      //! @param[in] ceiling maximum rate (Hz).
+      //! @param[in] now current time.
+      //! @return true if the message may be sent, false otherwise.
+      bool
+      admit(uint64_t key, double floor, double ceiling, double now)
+      {
+        double rate = floor + m_scale * (ceiling - floor);
+        if (rate <= 0)
+          return false;
+
+        std::map<uint64_t, double>::iterator itr = m_stimes.find(key);
+        if (itr != m_stimes.end() && now - itr->second < 1.0 / rate)
+          return false;
+
+        m_stimes[key] = now;
+        return true;
+      }
+
+      //! Get estimated loss.
+      //! @return loss [0, 1].
+      double
+      getLoss(void) const
+      {
+        return m_loss;
+      }
+
+      //! Get estimated queueing delay.
+      //! @return delay (s).
+      double
+      getDelay(void) const
+      {
+        return m_delay;
+      }
+
+      //! Get send rate scale.
+      //! @return scale [0, 1].
+      double
+      getScale(void) const
+      {
+        return m_scale;
+      }
+
+    private:
+      //! Time of last heartbeat.
+      double m_hb_last;
+      //! Latest heartbeat time stamp.
+      double m_hb_stamp;
+      //! Nominal heartbeat period.
+      double m_hb_period;
+      //! Recent heartbeat intervals.
+      std::deque<double> m_gaps;
+      //! Estimated loss.
+      double m_loss;
+      //! Recent one-way delays.
+      std::deque<double> m_owds;
+      //! Minimum recent one-way delay.
+      double m_owd_base;
+      //! Estimated queueing delay.
+      double m_delay;
+      //! Send rate scale.
+      double m_scale;
+      //! Time of last adaptation.
+      double m_adapted;
+      //! Last send times.
+      std::map<uint64_t, double> m_stimes;
+
+      //! Append a sample to a window, dropping the oldest one when full.
+      //! @param[in] window samples.
+      //! @param[in] value new sample.
+      //! @param[in] size window size.
+      static void
+      pushWindow(std::deque<double>& window, double value, unsigned size)
+      {
+        window.push_back(value);
+        if (window.size() > size)
+          window.pop_front();
+      }
+
+      //! Compute the lower quartile of a window.
+      //! @param[in] window samples (must not be empty).
+      //! @return lower quartile.
+      static double
+      getLowerQuartile(const std::deque<double>& window)
+      {
+        std::vector<double> values(window.begin(), window.end());
+        std::vector<double>::iterator pos = values.begin() + values.size() / 4;
+        std::nth_element(values.begin(), pos, values.end());
+        return *pos;
+      }
+
+      //! Fraction of heartbeats lost in an interval.
+      //! @param[in] dt interval.
+      //! @return loss [0, 1].
+      double
+      getGapLoss(double dt) const
+      {
+        if (m_hb_period <= 0)
+          return 0;
+
+        double missed = std::floor(dt / m_hb_period + 0.5) - 1.0;
+        if (missed <= 0)
+          return 0;
+
+        return missed / (missed + 1.0);
+      }
+    };
+  }
+}
+
+#endif
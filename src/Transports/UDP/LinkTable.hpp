@@ -0,0 +1,197 @@
+//***************************************************************************
+// Copyright 2007-2020 Universidade do Porto - Faculdade de Engenharia      *
+// Laboratório de Sistemas e Tecnologia Subaquática (LSTS)                  *
+//***************************************************************************
+// This file is part of DUNE: Unified Navigation Environment.               *
+//                                                                          *
+// Commercial Licence Usage                                                 *
+// Licencees holding valid commercial DUNE licences may use this file in    *
+// accordance with the commercial licence agreement provided with the       *
+// Software or, alternatively, in accordance with the terms contained in a  *
+// written agreement between you and Faculdade de Engenharia da             *
+// Universidade do Porto. For licensing terms, conditions, and further      *
+// information contact lsts@fe.up.pt.                                       *
+//                                                                          *
+// Modified European Union Public Licence - EUPL v.1.1 Usage                *
+// Alternatively, this file may be used under the terms of the Modified     *
+// EUPL, Version 1.1 only (the "Licence"), appearing in the file LICENCE.md *
+// included in the packaging of this file. You may not use this work        *
+// except in compliance with the Licence. Unless required by applicable     *
+// law or agreed to in writing, software distributed under the Licence is   *
+// distributed on an "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF     *
+// ANY KIND, either express or implied. See the Licence for the specific    *
+// language governing permissions and limitations at                        *
+// https://github.com/LSTS/dune/blob/master/LICENCE.md and                  *
+// http://ec.europa.eu/idabc/eupl.html.                                     *
+//***************************************************************************
+// Author: agent                                                            *
+//***************************************************************************
+
+#ifndef TRANSPORTS_UDP_LINK_TABLE_HPP_INCLUDED_
+#define TRANSPORTS_UDP_LINK_TABLE_HPP_INCLUDED_
+
+// ISO C++ 98 headers.
+#include <cstdio>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// DUNE headers.
+#include <DUNE/DUNE.hpp>
+
+// Local headers.
+#include "Link.hpp"
+
+namespace Transports
+{
+  namespace UDP
+  {
+    using DUNE_NAMESPACES;
+
+    //! Per-destination links and the adaptive rate configuration.
+    //! Updated by the listener thread and queried by the task.
+    class LinkTable
+    {
+    public:
+      LinkTable(void):
+        m_loss_thr(0.1),
+        m_delay_thr(0.5)
+      { }
+
+      //! Setup adaptive rates.
+      //! @param[in] spec list of 'Message:Floor:Ceiling' (Hz).
+      void
+      setupRates(const std::vector<std::string>& spec)
+      {
+        ScopedMutex l(m_mutex);
+        m_rates.clear();
+
+        for (unsigned i = 0; i < spec.size(); ++i)
+        {
+          std::vector<std::string> parts;
+          String::split(spec[i], ":", parts);
+
+          if (parts.size() == 3)
+          {
+            Range range;
+            if (std::sscanf(parts[1].c_str(), "%lf", &range.floor) == 1
+                && std::sscanf(parts[2].c_str(), "%lf", &range.ceiling) == 1
+                && range.floor >= 0 && range.ceiling > 0
+                && range.floor <= range.ceiling)
+            {
+              m_rates[IMC::Factory::getIdFromAbbrev(parts[0])] = range;
+              continue;
+            }
+          }
+
+          throw std::runtime_error(String::str(DTR("invalid adaptive rate: %s"),
+                                               spec[i].c_str()));
+        }
+      }
+
+      //! Set adaptation thresholds.
+      //! @param[in] loss loss threshold [0, 1].
+      //! @param[in] delay queueing delay threshold (s).
+      void
+      setThresholds(double loss, double delay)
+      {
+        ScopedMutex l(m_mutex);
+        m_loss_thr = loss;
+        m_delay_thr = delay;
+      }
+
+      //! Check if adaptive rates are configured.
+      //! @return true if configured, false otherwise.
+      bool
+      isActive(void)
+      {
+        ScopedMutex l(m_mutex);
+        return !m_rates.empty();
+      }
+
+      //! Account a heartbeat.
+      //! @param[in] msg heartbeat message.
+      //! @param[in] time arrival time, negative if not known.
+      void
+      onHeartbeat(const IMC::Message* msg, double time)
+      {
+        ScopedMutex l(m_mutex);
+        if (m_rates.empty())
+          return;
+
+        if (time < 0)
+          time = Clock::getSinceEpoch();
+
+        m_links[msg->getSource()].onHeartbeat(msg->getTimeStamp(), time);
+      }
+
+      //! Check if a message may be sent to a node now.
+      //! @param[in] id node identifier.
+      //! @param[in] msg message.
+      //! @return true if the message may be sent, false otherwise.
+      bool
+      admit(unsigned id, const IMC::Message* msg)
+      {
+        ScopedMutex l(m_mutex);
+
+        Rates::const_iterator ritr = m_rates.find(msg->getId());
+        if (ritr == m_rates.end())
+          return true;
+
+        double now = Clock::getSinceEpoch();
+        Link& link = m_links[id];
+        link.adapt(now, m_loss_thr, m_delay_thr);
+
+        uint64_t key = ((uint64_t)msg->getId() << 8) | msg->getSourceEntity();
+        return link.admit(key, ritr->second.floor, ritr->second.ceiling, now);
+      }
+
+      //! Retrieve link estimates of a node.
+      //! @param[in] id node identifier.
+      //! @param[out] loss estimated loss [0, 1].
+      //! @param[out] delay estimated queueing delay (s).
+      //! @param[out] scale send rate scale [0, 1].
+      //! @return true if the node is known, false otherwise.
+      bool
+      getEstimates(unsigned id, double& loss, double& delay, double& scale)
+      {
+        ScopedMutex l(m_mutex);
+        Links::const_iterator itr = m_links.find(id);
+        if (itr == m_links.end())
+          return false;
+
+        loss = itr->second.getLoss();
+        delay = itr->second.getDelay();
+        scale = itr->second.getScale();
+        return true;
+      }
+
+    private:
+      //! Rate range.
+      struct Range
+      {
+        //! Minimum rate (Hz).
+        double floor;
+        //! Maximum rate (Hz).
+        double ceiling;
+      };
+
+      typedef std::map<uint32_t, Range> Rates;
+      typedef std::map<unsigned, Link> Links;
+
+      //! Adaptive rates.
+      Rates m_rates;
+      //! Links by node identifier.
+      Links m_links;
+      //! Loss threshold.
+      double m_loss_thr;
+      //! Queueing delay threshold.
+      double m_delay_thr;
+      //! Lock.
+      Mutex m_mutex;
+    };
+  }
+}
+
+#endif
@@ -40,6 +40,7 @@
 // Local headers.
 #include "ContactTable.hpp"
 #include "LimitedComms.hpp"
+#include "LinkTable.hpp"
 
 namespace Transports
 {
@@ -51,12 +52,15 @@ namespace Transports
     {
     public:
       Listener(Tasks::Task& task, UDPSocket& sock, LimitedComms* lcomms,
+               LinkTable& links, IMC::DuplicateFilter* duplicates,
                float contact_timeout, bool trace = false):
         m_task(task),
         m_sock(sock),
         m_trace(trace),
         m_contacts(contact_timeout),
-        m_lcomms(lcomms)
+        m_lcomms(lcomms),
+        m_links(links),
+        m_duplicates(duplicates)
       {  }
 
       void
@@ -94,6 +98,10 @@ namespace Transports
       RWLock m_contacts_lock;
       // LimitedComms object
       LimitedComms* m_lcomms;
+      // Adaptive rate links.
+      LinkTable& m_links;
+      // Shared filter of duplicate messages, if enabled.
+      IMC::DuplicateFilter* m_duplicates;
 
       void
       run(void)
@@ -130,6 +138,17 @@ namespace Transports
             m_contacts.update(msg->getSource(), addr);
             m_contacts_lock.unlock();
 
+            if (msg->getId() == DUNE_IMC_HEARTBEAT)
+              m_links.onHeartbeat(msg, m_sock.getLastReadTime());
+
+            if (m_duplicates != NULL && !m_duplicates->accept(msg, bfr + DUNE_IMC_CONST_HEADER_SIZE,
+                                                              msg->getPayloadSerializationSize(),
+                                                              Clock::get()))
+            {
+              delete msg;
+              continue;
+            }
+
             m_task.dispatch(msg, DF_KEEP_TIME | DF_KEEP_SRC_EID);
 
             if (m_trace)
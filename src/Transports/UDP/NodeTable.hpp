@@ -41,6 +41,7 @@
 // Local headers.
 #include "Node.hpp"
 #include "LimitedComms.hpp"
+#include "LinkTable.hpp"
 
 namespace Transports
 {
@@ -53,7 +54,8 @@ namespace Transports
     public:
       NodeTable(void):
         m_active_count(0),
-        m_lcomms(NULL)
+        m_lcomms(NULL),
+        m_links(NULL)
       { }
 
       void
@@ -97,24 +99,20 @@ namespace Transports
       }
 
       void
-      send(UDPSocket& sock, const uint8_t* data, unsigned data_len, unsigned msgid)
+      send(UDPSocket& sock, const uint8_t* data, unsigned data_len, const IMC::Message* msg)
       {
-        if (m_lcomms != NULL)
-        {
-          if (m_lcomms->isActive())
-          {
-            for (Table::iterator itr = m_table.begin(); itr != m_table.end(); ++itr)
-            {
-              if (m_lcomms->isNodeWithinRange(itr->first, msgid))
-                itr->second.send(sock, data, data_len);
-            }
-
-            return;
-          }
-        }
+        bool limited = m_lcomms != NULL && m_lcomms->isActive();
 
         for (Table::iterator itr = m_table.begin(); itr != m_table.end(); ++itr)
+        {
+          if (limited && !m_lcomms->isNodeWithinRange(itr->first, msg->getId()))
+            continue;
+
+          if (m_links != NULL && !m_links->admit(itr->first, msg))
+            continue;
+
           itr->second.send(sock, data, data_len);
+        }
       }
 
       void
@@ -123,6 +121,12 @@ namespace Transports
         m_lcomms = lcomms;
       }
 
+      void
+      setLinkTable(LinkTable* links)
+      {
+        m_links = links;
+      }
+
     private:
       typedef std::map<unsigned, Node> Table;
       // Number of active nodes.
@@ -131,6 +135,8 @@ namespace Transports
       Table m_table;
       // Limited Comms object
       LimitedComms* m_lcomms;
+      // Adaptive rate links.
+      LinkTable* m_links;
     };
   }
 }
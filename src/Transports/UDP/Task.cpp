@@ -42,6 +42,7 @@
 #include "NodeTable.hpp"
 #include "Listener.hpp"
 #include "LimitedComms.hpp"
+#include "LinkTable.hpp"
 
 namespace Transports
 {
@@ -84,6 +85,14 @@ namespace Transports
       bool only_local;
       // Optional custom service type
       std::string custom_service;
+      // Adaptive rates.
+      std::vector<std::string> adaptive_rates;
+      // Loss threshold for rate adaptation.
+      double adapt_loss;
+      // Queueing delay threshold for rate adaptation.
+      double adapt_delay;
+      // Drop messages already received over another link.
+      bool filter_dups;
     };
 
     // Internal buffer size.
@@ -115,6 +124,8 @@ namespace Transports
       LimitedComms* m_lcomms;
       //! Message Filter
       MessageFilter m_filter;
+      //! Adaptive rate links.
+      LinkTable m_links;
 
       Task(const std::string& name, Tasks::Context& ctx):
         DUNE::Tasks::Task(name, ctx),
@@ -184,6 +195,28 @@ namespace Transports
         .defaultValue("")
         .description("Optional custom service type (imc+udp+<Custom Service Type>), empty entry gives default service (imc+udp)");
 
+        param("Adaptive Rates", m_args.adaptive_rates)
+        .defaultValue("")
+        .description("List of 'Message:Floor:Ceiling' rates (Hz) adapted per destination "
+                     "to the loss and delay of its link");
+
+        param("Adaptation - Loss Threshold", m_args.adapt_loss)
+        .defaultValue("10")
+        .minimumValue("0")
+        .maximumValue("100")
+        .units(Units::Percentage)
+        .description("Heartbeat loss above which adaptive rates are decreased");
+
+        param("Adaptation - Delay Threshold", m_args.adapt_delay)
+        .defaultValue("0.5")
+        .minimumValue("0")
+        .units(Units::Second)
+        .description("Queueing delay above which adaptive rates are decreased");
+
+        param("Filter Duplicates", m_args.filter_dups)
+        .defaultValue("true")
+        .description("Drop incoming messages already received over another link");
+
         // Allocate space for internal buffer.
         m_bfr = new uint8_t[c_bfr_size];
 
@@ -212,6 +245,10 @@ namespace Transports
         m_filter.setupRates(m_args.rate_lims);
         // Process filtered entities.
         m_filter.setupEntities(m_args.entities_flt, this);
+        // Process adaptive rates.
+        m_links.setupRates(m_args.adaptive_rates);
+        m_links.setThresholds(m_args.adapt_loss * 0.01, m_args.adapt_delay);
+        m_node_table.setLinkTable(m_links.isActive() ? &m_links : NULL);
 
         m_underwater_comms = m_args.underwater_comms;
 
@@ -260,6 +297,10 @@ namespace Transports
 
         inf(DTR("listening on %s:%u"), Address(Address::Any).c_str(), m_args.port);
 
+        // Arrival times of heartbeats feed the link delay estimates.
+        if (!m_sock.enableReceiveTimestamps(true))
+          debug("kernel receive time stamps are not available");
+
         if (m_args.announce_service)
         {
           // Initialize and dispatch AnnounceService.
@@ -298,7 +339,8 @@ namespace Transports
         m_node_table.setLimitedComms(m_lcomms);
 
         // Start listener thread.
-        m_listener = new Listener(*this, m_sock, m_lcomms,
+        m_listener = new Listener(*this, m_sock, m_lcomms, m_links,
+                                  m_args.filter_dups ? &m_ctx.duplicates : NULL,
                                   m_args.contact_timeout, m_args.trace_in);
         m_listener->start();
 
@@ -356,7 +398,7 @@ namespace Transports
         if (m_args.dynamic_nodes)
         {
           // Send to dynamic nodes.
-          m_node_table.send(m_sock, m_bfr, rv, msg->getId());
+          m_node_table.send(m_sock, m_bfr, rv, msg);
         }
       }
 
@@ -393,6 +435,13 @@ namespace Transports
           {
             if (m_node_table.activate(itr->getId(), itr->getAddress()))
               inf(DTR("activating transmission to node '%s'"), name.c_str());
+
+            double loss = 0;
+            double delay = 0;
+            double scale = 0;
+            if (m_links.getEstimates(itr->getId(), loss, delay, scale))
+              debug("link to '%s': loss %.1f %%, delay %.3f s, rate scale %.2f",
+                    name.c_str(), loss * 100.0, delay, scale);
           }
           else
           {
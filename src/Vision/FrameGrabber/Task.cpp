@@ -46,6 +46,9 @@ namespace Vision
   {
     using DUNE_NAMESPACES;
 
+    //! Fraction of frames encoded while throttled (one in N).
+    static const unsigned c_throttled_ratio = 2;
+
     struct Arguments
     {
       //! Video device.
@@ -144,7 +147,14 @@ namespace Vision
       void
       task(void)
       {
+        // Frames are always captured so that the device queue does
+        // not go stale, but encoding is skipped for some while the
+        // system is overloaded.
         m_video->frameCapture();
+
+        if (isThrottled() && getRunCount() % c_throttled_ratio != 0)
+          return;
+
         m_jpeg.compress(m_video->frameData(), m_args.jpeg_quality);
 
         const char* img = (const char*)(m_jpeg.imageData());